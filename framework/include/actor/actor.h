@@ -5,6 +5,12 @@
 #include "mail/types.h"
 #include "mail/message.h"
 #include "actor/types.h"
+#include "actor/serializer.h"
+#include "actor/clock.h"
+#include "actor/counters.h"
+#include "actor/output.h"
+#include "actor/snapshots.h"
+#include "actor/termination.h"
 
 namespace actor {
 
@@ -21,6 +27,15 @@ namespace actor {
     public:
         actor::id id;            // Uniquely identifies an actor
         mail::Mailbox mailbox;   // Allows actor to send and receive messages
+        actor::Clock clock;      // Logical time of the actor, maintained by the framework
+        actor::ReplicatedCounters *counters = nullptr;   // In real time, counters replicated on all MPI processes,
+                                                         // if enabled (owned by the framework)
+        actor::Output *output = nullptr;                 // Records written to the output file of the framework,
+                                                         // if enabled (owned by the framework)
+        actor::Snapshots *snapshots = nullptr;           // Records streamed to the snapshot file of current MPI
+                                                         // process while running, if enabled (owned by the framework)
+        actor::Termination *termination = nullptr;       // In real time, global stop of all actors, if enabled
+                                                         // (owned by the framework)
 
     public:
 
@@ -36,6 +51,26 @@ namespace actor {
 
         virtual next_step run() = 0;
 
+        virtual double next_event_time();
+
+        virtual double lookahead();
+
+        virtual std::vector<actor::id> channels();
+
+        virtual double channel_lookahead(actor::id to);
+
+        virtual bool serialize(Serializer &serializer);
+
+        virtual bool deserialize(Deserializer &deserializer);
+
+        virtual bool checkpoint(Serializer &serializer);
+
+        virtual bool restore(Deserializer &deserializer);
+
+        virtual next_step terminate();
+
+        virtual bool idle();
+
         virtual ~Actor();
 
         void finalize();
@@ -0,0 +1,25 @@
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#define CHECKPOINT_MAGIC 0x54504B43   // Marks the trailer of a checkpoint file
+
+namespace actor {
+
+    /**
+     * Trailer of a checkpoint file written by the framework (see `ParallelActorModel::write_checkpoint`).
+     *
+     * A checkpoint file holds the records of all MPI processes in order of key, then the index of the records,
+     * i.e. the key and size in bytes of each record as pairs of longs, then this trailer:
+     * - The record of an actor holds the state written by its `checkpoint` method, under the ID of the actor.
+     * - The record of an MPI process holds its replica of the counters and its share of the reduced messages,
+     *   under the key -1 - rank.
+     */
+    struct CheckpointTrailer {
+        int magic;                   // CHECKPOINT_MAGIC
+        int num_procs;               // Number of MPI processes that wrote the checkpoint
+        long num_records;            // Number of records, i.e. of pairs in the index
+        long long wall_nanoseconds;  // Wall time of actors when the checkpoint was written
+    };
+}
+
+#endif
@@ -0,0 +1,36 @@
+#ifndef CLOCK_H
+#define CLOCK_H
+
+#include <limits>
+
+// Time of an event that never happens
+#define NO_EVENT std::numeric_limits<double>::infinity()
+
+#define NANOSECONDS_PER_SECOND 1000000000LL
+
+namespace actor {
+
+    /**
+     * Time modes of the framework's execution cycle.
+     */
+    enum time_mode {
+        REAL_TIME,   // Actors run continuously and follow the wall clock
+        WINDOWED,    // Actors run a discrete event simulation in logical time, synchronized in global windows
+        NULL_MESSAGES,   // Actors run a discrete event simulation in logical time, synchronized by null messages
+        OPTIMISTIC,      // Actors run a discrete event simulation in logical time, speculatively with rollback
+        BSP,             // Actors run in lockstep ticks of logical time, exchanging messages collectively between ticks
+    };
+
+    /**
+     * Logical time of an actor, maintained by the framework.
+     */
+    struct Clock {
+        time_mode mode = REAL_TIME;   // Time mode of the framework
+        double safe_time = 0;         // In logical time, the actor may process events with timestamps below this time
+        double local_time = 0;        // In logical time, the actor will not process events below this time anymore
+        long long wall_time = 0;      // In real time, nanoseconds elapsed on the monotonic clock since actors started,
+                                      // read once per execution cycle
+    };
+}
+
+#endif
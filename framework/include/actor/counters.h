@@ -0,0 +1,36 @@
+#ifndef COUNTERS_H
+#define COUNTERS_H
+
+#include <vector>
+
+namespace actor {
+
+    /**
+     * Counters replicated on every MPI process, which actors increment and read without exchanging messages.
+     *
+     * - An increment applies to the replica of current MPI process right away, and reaches the replicas of other
+     *   MPI processes with the next reduction epoch of the framework (see `ParallelActorModel::reduce_messages`).
+     *   A read thus misses at most the increments made by other MPI processes within the last two epochs.
+     * - As with a PN-counter CRDT, increments commute, so all replicas converge to the same values. Rather than
+     *   exchanging the per-process counts, the framework merges the increments of all MPI processes by summing
+     *   them in the non-blocking all-reduce of each epoch.
+     */
+    class ReplicatedCounters {
+    public:
+        std::vector<long> merged;     // Increments of all MPI processes merged by completed epochs
+        std::vector<long> pending;    // Increments of current MPI process contributed to the pending epoch
+        std::vector<long> local;      // Increments of current MPI process since the last epoch started
+
+    public:
+
+        void resize(int num_counters);
+
+        int size() const;
+
+        void add(int counter, long value);
+
+        long get(int counter) const;
+    };
+}
+
+#endif
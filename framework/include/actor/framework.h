@@ -2,12 +2,31 @@
 #define FRAMEWORK_H
 
 #include <vector>
+#include <deque>
+#include <map>
+#include <string>
 #include <unordered_map>
 #include "actor/actor.h"
+#include "actor/placement.h"
+#include "actor/clock.h"
+#include "actor/history.h"
+#include "actor/checkpoint.h"
+#include "actor/profile.h"
+#include "actor/trace.h"
 #include "mail/types.h"
+#include "mail/directory.h"
 
 #define MPI_BUFFER_SIZE 1024*1024*10
 #define MAX_NUM_MESSAGE_PER_ITERATION 20
+#define MIGRATION_INTERVAL 5.0     // Seconds between load balancing epochs when migration is enabled
+#define MIGRATION_THRESHOLD 1.1    // Actors migrate when the most loaded process exceeds the average by this factor
+#define MIGRATION_TAG 0            // Tag of messages carrying migrated actors between framework instances
+#define NULL_MESSAGE_TAG 1         // Tag of null messages between framework instances
+#define OPTIMISTIC_WINDOW 10       // In optimistic execution, actors run at most this many lookaheads beyond GVT
+#define GVT_INTERVAL 0.01          // Seconds between GVT computations in optimistic execution
+#define REDUCTION_INTERVAL 0.05    // Seconds between reduction epochs, which deliver reduced messages and merge counters
+#define TRACE_CAPACITY 1048576     // Events kept per MPI process when tracing, the oldest being overwritten once full
+#define CHECKPOINT_SUFFIX ".tmp"   // Suffix of a checkpoint file being written, which replaces the previous one once complete
 
 /**
  * A framework for the actor model.
@@ -19,6 +38,45 @@
  *   These actors are added to the framework using the `addActor` method.
  * - An MPI process managing a single actor is referred to as handling an isolated actor.
  *   Such an actor is added to the framework using the `addIsolatedActor` method.
+ * - Every MPI process must add every actor, in the same order. Both methods accept either an actor object,
+ *   which is destroyed unless current process handles it, or a callback that creates the actor object
+ *   and is only called by the MPI process handling the actor.
+ * - By default, grouped actors are assigned to MPI processes in blocks of `num_actors_per_procs`, in the order they
+ *   are added. If the communication graph between grouped actors is provided via the `setTopology` method,
+ *   the graph is partitioned instead, so that actors exchanging messages are likely to share an MPI process.
+ * - Actors may differ in computational load. If a weight per grouped actor is provided, either as the vertex
+ *   weights of the topology or via the `setWeights` method, MPI processes are balanced by total weight
+ *   rather than by number of actors. `num_actors_per_procs` is then the average number of actors per process.
+ * - When migration is enabled via the `enableMigration` method, grouped actors that support serialization are
+ *   periodically moved from overloaded to underloaded MPI processes (see `balance_load` method).
+ * - By default, actors run in real time. The `setTimeMode` method switches the execution cycle to a discrete
+ *   event simulation in logical time, where messages carry timestamps and the framework bounds how far in
+ *   logical time each actor may advance (see `run_windowed` and `run_null_messages` methods), or lets actors
+ *   advance speculatively and rolls them back on conflicts (see `run_optimistic` method), or runs all actors
+ *   in lockstep ticks with one collective message exchange per tick (see `run_bsp` method).
+ *   Migration only applies in real time.
+ * - Messages that many actors send to the same actor, such as periodic statistics, may be reduced instead
+ *   via the `addReduction` method, so that the receiving actor gets one message per reduction epoch rather
+ *   than one per sending actor. Reductions only apply in real time.
+ * - Via the `enableCounters` method, actors share counters replicated on all MPI processes, which the framework
+ *   merges with each reduction epoch (see `actor::ReplicatedCounters`). Counters only apply in real time.
+ * - Via the `enableOutput` method, actors write records that all MPI processes write collectively to a file
+ *   with MPI-IO once all actors stopped (see `write_output` method), rather than sending them to one actor.
+ * - Via the `enableSnapshots` method, actors stream records to one file per MPI process while running, which
+ *   a background thread writes (see `actor::Snapshots`). MPI must then be initialized with at least
+ *   MPI_THREAD_FUNNELED. Snapshots do not apply in optimistic execution, where actors may roll back.
+ * - Via the `enableTermination` method, any actor may stop all actors on all MPI processes, and the framework
+ *   may detect that no work remains (see `actor::Termination`), rather than one actor messaging every other
+ *   actor to stop. Global termination only applies in real time.
+ * - Via the `enableCheckpoints` method, the framework periodically writes the state of all actors to a checkpoint
+ *   file (see `write_checkpoint` method), and via the `restoreCheckpoint` method, a run resumes from it instead of
+ *   initializing actors, possibly on a different number of MPI processes. Checkpoints only apply in real time.
+ * - Via the `enableProfiling` method, the framework measures the time spent in each actor and the rate of its
+ *   execution cycle, and writes them along with its message counters to one file per MPI process once all actors
+ *   stopped, while rank 0 prints a summary across all MPI processes (see `actor::Profile`).
+ * - Via the `enableTracing` method, the framework records the timeline of actors and messages on each MPI process
+ *   and writes it to a Chrome trace file once all actors stopped (see `actor::Trace`). When neither profiling nor
+ *   tracing is enabled, instrumenting a call of `ingress` or `run` costs a single branch.
  */
 class ParallelActorModel {
 public:
@@ -31,11 +89,88 @@ public:
 
     int grouped_actors_size;             // Current number of grouped actors across all MPI processes
     int num_procs_for_grouped_actors;    // Current number of processes that manages grouped actors
+    int num_parts;                       // Number of processes reserved for grouped actors by the placement
+    std::vector<int> actor_placement;    // Rank of each grouped actor computed by `setTopology` or `setWeights`
+    std::vector<int> num_actors_by_rank; // Number of grouped actors assigned so far to each rank by the placement
     std::unordered_map<actor::id, actor::Actor *> actors;        // Collection of actors managed by current MPI process
-    std::unordered_map<actor::id, mail::Address> id_to_address;  // Map of actor ID to its mailbox address
+    mail::Directory id_to_address;       // Map of actor ID to its mailbox address
     std::vector<mail::Type> mail_types;  // List of data types supported by the messaging system between actors
     int rank = 0;
     int num_procs = 0;
+    long long start_nanoseconds = 0;     // Time on the monotonic clock at which actors started
+
+    // Migration
+    bool migration_mode = false;         // Actors migrate between MPI processes to balance load when true
+    actor::constructor constructor;      // Creates the actor objects of actors migrating to current MPI process
+    MPI_Comm framework_comm;             // Communicator for messages exchanged between framework instances
+    MPI_Request epoch_request;           // Pending barrier that starts the next load balancing epoch
+    double last_epoch_time = 0;          // Time at which the last load balancing epoch finished
+    int num_sweeps = 0;                  // Number of execution cycles since the last load balancing epoch
+    int next_tag = 0;                    // Tag assigned to the next actor migrating to current MPI process
+    std::unordered_map<actor::id, double> actor_load;  // Seconds spent in each actor since the last epoch
+    std::unordered_map<int, actor::id> forwarding;     // Tags of actors that migrated away from current process
+    std::vector<int> free_tags;          // Tags of actors that migrated away, reused by actors migrating here
+
+    // Logical time
+    actor::time_mode time_mode = actor::REAL_TIME;     // Time mode of the execution cycle
+    double global_lookahead = 0;         // Minimum lookahead of all actors across all MPI processes
+    mail::Counters counters;             // Number of messages sent and received by actors of current MPI process
+    std::vector<int> stopped_tags;       // Tags of actors of current MPI process that stopped
+
+    // Null messages
+    std::unordered_map<actor::id, std::vector<std::pair<actor::id, double>>> local_channels;  // Local senders and lookahead of the channels into each local actor
+    std::unordered_map<actor::id, std::vector<int>> remote_channels;                          // Ranks sending on channels into each local actor
+    std::unordered_map<int, std::vector<std::pair<actor::id, double>>> outgoing_channels;     // Local senders and lookahead of the channels into each other rank
+    std::vector<double> channel_clock;   // Timestamp below which no more messages arrive from each rank
+    std::vector<double> null_sent;       // Time sent in the last null message to each rank
+    std::vector<std::deque<std::pair<long, double>>> null_received;  // Null messages from each rank awaiting earlier messages
+
+    // Optimistic execution
+    std::unordered_map<actor::id, actor::History> histories;   // History of each local actor
+    double gvt = 0;                      // Global virtual time, below which no event is rolled back anymore
+    long num_rollbacks = 0;              // Number of rollbacks of local actors
+
+    // Bulk synchronous execution
+    mail::Outbox outbox;                 // Messages sent by local actors during the current tick
+    std::unordered_map<actor::id, std::vector<mail::Message>> inboxes;   // Messages received by each local actor
+
+    // Reductions and replicated counters
+    std::vector<mail::Reduction> reductions;     // Messages summed across all MPI processes before delivery
+    actor::ReplicatedCounters counters_replica;  // Replica of the counters shared by actors on current MPI process
+    bool reduction_mode = false;                 // Reduction epochs run when true
+    MPI_Comm reduction_comm;                     // Communicator for reduction epochs
+    MPI_Request reduction_request = MPI_REQUEST_NULL;   // Pending reduction epoch
+    std::vector<long> reduction_contribution;    // Sums of current MPI process in the pending epoch
+    std::vector<long> reduction_result;          // Sums across all MPI processes in the pending epoch
+    double last_reduction_time = 0;              // Time at which the last reduction epoch started
+
+    // Output
+    actor::Output output;                // Records written by actors of current MPI process
+    std::string output_filename;         // File to which records are written once all actors stopped, if any
+
+    // Snapshots
+    actor::Snapshots snapshots;          // Records streamed by actors of current MPI process while running
+    std::string snapshots_prefix;        // Prefix of the snapshot file of each MPI process, if any
+
+    // Global termination
+    actor::Termination termination;      // Global stop of all actors, shared by actors of current MPI process
+    bool termination_mode = false;       // Actors may stop all actors via the reduction epochs when true
+
+    // Checkpoints
+    std::string checkpoint_filename;     // File to which checkpoints are written, if any
+    long checkpoint_epochs = 0;          // Number of reduction epochs between checkpoints
+    long num_epochs = 0;                 // Number of reduction epochs completed
+    bool checkpoint_due = false;         // With migration, a checkpoint is written in the next load balancing epoch
+    std::string restore_filename;        // Checkpoint file from which actors resume, if any
+
+    // Profiling
+    actor::Profile profile;              // Time spent in actors and execution cycles of current MPI process
+    std::string profile_prefix;          // Prefix of the profile file of each MPI process, if any
+
+    // Tracing
+    actor::Trace trace;                  // Timeline of actors and messages of current MPI process
+    std::string trace_filename;          // File to which the timeline of all MPI processes is written, if any
+    bool instrumented = false;           // Calls of `ingress` and `run` are profiled or traced when true
 
 public:
 
@@ -44,20 +179,139 @@ public:
                                 bool log_debug = false,
                                 int max_num_message_per_iteration = MAX_NUM_MESSAGE_PER_ITERATION);
 
+    bool setTopology(const placement::Graph &graph);
+
+    bool setWeights(const std::vector<int> &weights);
+
     bool addActor(actor::Actor *actor);
 
+    bool addActor(actor::id id, const actor::constructor &actor_constructor);
+
     bool addIsolatedActor(actor::Actor *actor);
 
+    bool addIsolatedActor(actor::id id, const actor::constructor &actor_constructor);
+
     void addType(mail::Type type);
 
+    bool addReduction(actor::id to, MPI_Datatype mpi_datatype);
+
+    void enableCounters(int num_counters);
+
+    void enableOutput(const std::string &filename, actor::chunk_format format = nullptr);
+
+    void enableSnapshots(const std::string &prefix);
+
+    void enableTermination(bool quiescence = false);
+
+    void enableCheckpoints(const std::string &filename, double interval_seconds);
+
+    void restoreCheckpoint(const std::string &filename);
+
+    void enableProfiling(const std::string &prefix);
+
+    void enableTracing(const std::string &filename, long capacity = TRACE_CAPACITY);
+
+    void enableMigration(actor::constructor actor_constructor);
+
+    void setTimeMode(actor::time_mode mode);
+
     void start();
 
 private:
 
+    bool reserve_procs_for_placement(int num_actors);
+
+    void log_placement(const std::vector<int> &weights);
+
+    mail::Address assign_grouped_address(actor::id id);
+
+    void store_actor(actor::Actor *actor, mail::Address address);
+
+    int num_procs_in_use_by_grouped_actors() const;
+
     bool initialize_actors();
 
+    bool restore_checkpoint();
+
+    actor::next_step receive_messages(actor::Actor *actor, int max_num_messages);
+
+    actor::next_step ingress(actor::Actor *actor, mail::Message &message);
+
+    actor::next_step run(actor::Actor *actor);
+
     void finalize_actors(std::vector<actor::id> &stopped_actors);
 
+    void run_real_time();
+
+    bool reduce_messages();
+
+    bool complete_reduction();
+
+    void start_reduction();
+
+    void align_reductions(MPI_Comm comm);
+
+    void terminate_actors();
+
+    void write_checkpoint(MPI_Comm comm);
+
+    void run_windowed();
+
+    void drain_messages();
+
+    void deliver_messages();
+
+    void run_null_messages();
+
+    bool connect_channels();
+
+    double local_time(actor::id id);
+
+    void receive_null_messages();
+
+    void send_null_messages();
+
+    bool compute_global_lookahead();
+
+    void discard_dead_letters();
+
+    void run_optimistic();
+
+    void receive_inputs(actor::Actor *actor, actor::History &history);
+
+    void cancel_input(actor::Actor *actor, actor::History &history, const mail::Message &anti_message);
+
+    void rollback(actor::Actor *actor, actor::History &history, int checkpoint_index);
+
+    bool process_batch(actor::Actor *actor, actor::History &history, double limit);
+
+    actor::next_step process_committed(actor::Actor *actor, actor::History &history);
+
+    bool advance_gvt();
+
+    void run_bsp();
+
+    actor::next_step run_tick(actor::Actor *actor, std::vector<mail::Message> &inbox, double end_time);
+
+    void exchange_messages();
+
+    bool write_output();
+
+    void write_profile();
+
+    bool write_trace();
+
+    bool write_records(const std::string &filename, const std::map<long, std::string> &records, MPI_Comm comm,
+                       std::vector<long> *index = nullptr);
+
+    bool balance_load();
+
+    void recycle_tags();
+
+    void migrate_actors(const std::vector<double> &load_by_rank);
+
+    void forward_messages();
+
 };
 
 #endif
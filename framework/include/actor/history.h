@@ -0,0 +1,55 @@
+#ifndef HISTORY_H
+#define HISTORY_H
+
+#include <deque>
+#include <map>
+#include <string>
+#include <vector>
+#include "actor/output.h"
+#include "mail/message.h"
+#include "mail/types.h"
+
+#define UNPROCESSED -1   // Batch of a received message that its actor has yet to process
+
+namespace actor {
+
+    /**
+     * State of an actor saved before a batch of events, to which the actor returns when rolled back.
+     */
+    struct Checkpoint {
+        double time;               // Local time of the actor before the batch
+        long batch;                // Batch of events processed from this state
+        std::vector<char> state;   // State written by the actor's `serialize` method
+        std::map<long, std::string> records;   // Records written by the actor to its output before the batch
+    };
+
+    /**
+     * A message received by an actor, kept until it can no longer be rolled back.
+     */
+    struct Input {
+        mail::Message message;
+        long batch;                // Batch of events in which the actor processed the message, or UNPROCESSED
+    };
+
+    /**
+     * History of an actor in optimistic execution, kept by the framework:
+     *
+     * - Actors that support serialization are reversible. They process events speculatively, and are rolled back
+     *   to a checkpoint whenever a message arrives in their past or a message they processed is cancelled.
+     * - Other actors only process messages and events that can no longer be rolled back.
+     * - A reversible actor that stops does so speculatively: it is rolled back like any other, by a message with a
+     *   timestamp up to the time at which it stopped, and only finalized once GVT passes that time. Until then,
+     *   the records it writes to its output are kept with its state, and only then handed to the framework.
+     */
+    struct History {
+        bool reversible = false;              // True if the actor supports rollback
+        mail::Journal journal;                // Messages sent by the actor which may still be cancelled
+        std::deque<Checkpoint> checkpoints;   // Checkpoints of the actor which may still be returned to
+        std::vector<Input> inputs;            // Messages received by the actor which may still be rolled back
+        long stop_batch = 0;                  // Batch in which the actor stopped speculatively, 0 while it runs
+        double stop_time = 0;                 // Messages up to this timestamp roll back the speculative stop
+        actor::Output output;                 // Records written by the actor which may still be rolled back
+    };
+}
+
+#endif
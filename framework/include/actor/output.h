@@ -0,0 +1,33 @@
+#ifndef OUTPUT_H
+#define OUTPUT_H
+
+#include <map>
+#include <string>
+
+namespace actor {
+
+    // Returns the chunk of the output file holding the given records of an MPI process
+    typedef std::string (*chunk_format)(const std::map<long, std::string> &records);
+
+    /**
+     * Records that actors write to the output file of the framework, one record per key.
+     *
+     * - Each MPI process collects the records of its actors. Once all actors stopped, the framework writes the
+     *   records of all MPI processes to the output file, ordered by key (see `ParallelActorModel::write_output`).
+     * - Writing a record again under the same key replaces it, so that an actor re-executed after a rollback
+     *   leaves a single record.
+     * - If a chunk format is provided, the records of each MPI process are written as a single chunk instead,
+     *   e.g. to lay them out by columns, and chunks are ordered by rank.
+     */
+    class Output {
+    public:
+        std::map<long, std::string> records;   // Bytes of each record by key
+        chunk_format format = nullptr;         // Merges the records of an MPI process into a chunk, if provided
+
+    public:
+
+        void write(long key, const std::string &record);
+    };
+}
+
+#endif
@@ -0,0 +1,41 @@
+#ifndef PLACEMENT_H
+#define PLACEMENT_H
+
+#include <vector>
+
+#define COARSEST_GRAPH_SIZE 64      // Stop coarsening once a graph has at most this many vertices
+#define MIN_COARSENING_RATIO 0.95   // Stop coarsening when a level removes fewer than 5% of the vertices
+#define MAX_IMBALANCE 1.03          // Maximum allowed ratio of a part's weight to its target weight
+#define REFINEMENT_PASSES 4         // Number of boundary refinement passes at each uncoarsening level
+
+namespace placement {
+
+    /**
+     * An undirected communication graph between actors in compressed sparse row (CSR) format.
+     *
+     * - Vertex i corresponds to the grouped actor with ID i.
+     * - An edge between two vertices indicates that the corresponding actors exchange messages.
+     *   Its weight is a measure of the communication volume between the actors.
+     * - The weight of a vertex is a measure of the computational load of the corresponding actor.
+     */
+    struct Graph {
+        std::vector<int> xadj;     // Adjacency list of vertex i is adjncy[xadj[i]] to adjncy[xadj[i + 1] - 1]
+        std::vector<int> adjncy;   // Concatenated adjacency lists of all vertices
+        std::vector<int> adjwgt;   // Weight of each edge in `adjncy`
+        std::vector<int> vwgt;     // Weight of each vertex
+
+        Graph();
+
+        explicit Graph(const std::vector<std::vector<int>> &adjacency);
+
+        int size() const;
+    };
+
+    std::vector<int> partition(const Graph &graph, int num_parts);
+
+    std::vector<int> blocks(const std::vector<int> &weights, int num_parts);
+
+    int edge_cut(const Graph &graph, const std::vector<int> &parts);
+}
+
+#endif
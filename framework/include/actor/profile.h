@@ -0,0 +1,54 @@
+#ifndef PROFILE_H
+#define PROFILE_H
+
+#include <string>
+#include <unordered_map>
+#include "actor/types.h"
+#include "mail/types.h"
+
+namespace actor {
+
+    /**
+     * Time spent by the framework in the methods of an actor, on current MPI process.
+     */
+    struct ActorProfile {
+        long ingress_calls = 0;              // Number of messages processed via `ingress`
+        long long ingress_nanoseconds = 0;   // Time spent in `ingress`
+        long run_calls = 0;                  // Number of calls of `run`
+        long long run_nanoseconds = 0;       // Time spent in `run`
+        int max_batch = 0;                   // Maximum number of messages received in one execution cycle
+        long backlogged_cycles = 0;          // Execution cycles that left messages in the mailbox, having received
+                                             // the maximum number of messages per execution cycle
+    };
+
+    /**
+     * Profile of the execution cycle of an MPI process, collected by the framework when profiling is enabled.
+     *
+     * - Time spent in actors is measured around each call of their `ingress` and `run` methods. When profiling
+     *   is disabled, a call costs a single branch.
+     * - Messages and payload bytes sent and received by type, and the probes of mailboxes, are counted by the
+     *   mailboxes in `mail::Counters`, whether profiling is enabled or not.
+     * - MPI does not report the use of the buffer attached for MPI_Bsend. Its high-water mark is estimated as the
+     *   largest number of bytes sent with MPI_Bsend within one execution cycle.
+     */
+    class Profile {
+    public:
+        bool enabled = false;                // Time spent in actors is measured when true
+        std::unordered_map<actor::id, ActorProfile> actors;   // Profile of each actor that ran on this process
+        long cycles = 0;                     // Number of execution cycles
+        long long start_nanoseconds = 0;     // Time on the monotonic clock at which the execution cycle started
+        long long end_nanoseconds = 0;       // Time on the monotonic clock at which the execution cycle ended
+        long last_bytes_sent = 0;            // Bytes sent with MPI_Bsend by the end of the previous execution cycle
+        long max_cycle_bytes = 0;            // Largest number of bytes sent with MPI_Bsend in one execution cycle
+
+    public:
+
+        void count_cycle(const mail::Counters &counters);
+
+        double seconds() const;
+
+        bool write(const std::string &filename, int rank, const mail::Counters &counters) const;
+    };
+}
+
+#endif
@@ -0,0 +1,78 @@
+#ifndef SERIALIZER_H
+#define SERIALIZER_H
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace actor {
+
+    /**
+     * Appends the state of an actor to a byte buffer, e.g. to migrate the actor to another MPI process.
+     * Only trivially copyable values are written as raw bytes; pointers must be converted to indices beforehand.
+     */
+    class Serializer {
+    public:
+        std::vector<char> &buffer;   // Buffer receiving the serialized state
+
+    public:
+
+        explicit Serializer(std::vector<char> &buffer) : buffer(buffer) {}
+
+        template<typename T>
+        void write(const T &value) {
+            auto offset = buffer.size();
+            buffer.resize(offset + sizeof(T));
+            std::memcpy(buffer.data() + offset, &value, sizeof(T));
+        }
+
+        template<typename T>
+        void write(const std::vector<T> &values) {
+            write(static_cast<int>(values.size()));
+            auto offset = buffer.size();
+            buffer.resize(offset + values.size() * sizeof(T));
+            std::memcpy(buffer.data() + offset, values.data(), values.size() * sizeof(T));
+        }
+
+        void write(const std::string &value) {
+            write(std::vector<char>(value.begin(), value.end()));
+        }
+    };
+
+    /**
+     * Reads back the state of an actor written by a Serializer, in the same order it was written.
+     */
+    class Deserializer {
+    public:
+        const char *data;   // Serialized state
+        int size;           // Size of serialized state in bytes
+        int offset;         // Position of the next value to be read
+
+    public:
+
+        Deserializer(const char *data, int size) : data(data), size(size), offset(0) {}
+
+        template<typename T>
+        void read(T &value) {
+            std::memcpy(&value, data + offset, sizeof(T));
+            offset += sizeof(T);
+        }
+
+        template<typename T>
+        void read(std::vector<T> &values) {
+            int count;
+            read(count);
+            values.resize(count);
+            std::memcpy(values.data(), data + offset, count * sizeof(T));
+            offset += count * static_cast<int>(sizeof(T));
+        }
+
+        void read(std::string &value) {
+            std::vector<char> characters;
+            read(characters);
+            value = std::string(characters.begin(), characters.end());
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,50 @@
+#ifndef SNAPSHOTS_H
+#define SNAPSHOTS_H
+
+#include <condition_variable>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace actor {
+
+    /**
+     * Records that actors stream to the snapshot file of current MPI process while they run, e.g. for live
+     * monitoring of long runs.
+     *
+     * - Actors append records to the front buffer. Once per execution cycle, the framework swaps the front buffer
+     *   with the back buffer, unless the back buffer is still being written (see `flush` method).
+     * - A background thread writes the back buffer to the file, so that the execution cycle never waits for
+     *   the file system. The thread makes no MPI calls.
+     */
+    class Snapshots {
+    public:
+        std::string front;                 // Records written by actors since the last swap
+        std::string back;                  // Records being written to the file by the writer thread
+        std::FILE *file = nullptr;         // Snapshot file of current MPI process
+        std::thread writer;                // Writes the back buffer to the file
+        std::mutex mutex;                  // Guards `pending` and `closing`
+        std::condition_variable ready;     // Signals the writer thread that the back buffer is pending or closing
+        bool pending = false;              // The back buffer awaits writing
+        bool closing = false;              // The writer thread writes the front buffer and exits once set
+
+    public:
+
+        ~Snapshots();
+
+        bool open(const std::string &filename);
+
+        void write(const std::string &record);
+
+        void flush();
+
+        void close();
+
+    private:
+
+        void write_buffers();
+    };
+}
+
+#endif
@@ -0,0 +1,34 @@
+#ifndef TERMINATION_H
+#define TERMINATION_H
+
+#include <unordered_set>
+#include "actor/types.h"
+
+namespace actor {
+
+    /**
+     * Global stop of all actors on all MPI processes, detected by the framework rather than signalled by one
+     * actor messaging every other actor.
+     *
+     * - Any actor may request the global stop. The request reaches every MPI process with the next reduction
+     *   epoch of the framework (see `ParallelActorModel::reduce_messages`), which then calls the `terminate`
+     *   method of each of its actors once.
+     * - With quiescence detection, the framework also stops all actors once no work remains, i.e. once all actors
+     *   are idle and every message sent has been received, in two consecutive epochs with the same number of
+     *   messages sent (four-counter method).
+     */
+    class Termination {
+    public:
+        bool requested = false;     // An actor of current MPI process requested the global stop
+        bool quiescence = false;    // The framework stops all actors once no work remains when true
+        bool stopping = false;      // The global stop reached current MPI process
+        long last_sent = -1;        // Messages sent on all MPI processes in the last epoch, if quiescent
+        std::unordered_set<actor::id> notified;   // Actors of current MPI process notified of the global stop
+
+    public:
+
+        void request();
+    };
+}
+
+#endif
@@ -0,0 +1,64 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <string>
+#include <vector>
+#include "actor/types.h"
+
+namespace actor {
+
+    /**
+     * Kinds of events recorded in a trace.
+     */
+    enum trace_kind {
+        TRACE_INGRESS_BEGIN,   // An actor starts processing a message via its `ingress` method
+        TRACE_INGRESS_END,     // An actor finished processing a message via its `ingress` method
+        TRACE_RUN_BEGIN,       // An actor starts running via its `run` method
+        TRACE_RUN_END,         // An actor finished running via its `run` method
+        TRACE_SEND,            // An actor sends a message
+        TRACE_RECEIVE,         // A message is received for an actor
+    };
+
+    /**
+     * Event recorded in a trace.
+     */
+    struct TraceEvent {
+        long long nanoseconds;     // Time on the monotonic clock
+        unsigned long long flow;   // For messages, identifies the message on both the sending and receiving side
+        actor::id id;              // ID of the actor, -1 outside of actors
+        trace_kind kind;
+    };
+
+    /**
+     * Timeline of the actors of an MPI process, recorded by the framework when tracing is enabled.
+     *
+     * - Events are recorded into a ring buffer of fixed capacity allocated up front, which keeps the latest events
+     *   once full. Only the thread running the execution cycle records events, so the buffer takes no lock.
+     * - A message is identified on both sides by its sending actor and sequence number when its sender records them
+     *   (see `mail::Header`), or else by the rank of its sender and a sequence number drawn from the trace of that
+     *   MPI process, carried in the header.
+     * - Events are formatted as the Chrome trace event format, with one process per rank and one thread per actor,
+     *   where each message is a flow from the slice that sent it to the next slice of its receiver.
+     */
+    class Trace {
+    public:
+        bool enabled = false;               // Events are recorded when true
+        int rank = 0;                       // Rank of current MPI process
+        actor::id current = -1;             // Actor on whose behalf current MPI process runs, -1 otherwise
+        long next_sequence = 0;             // Sequence number of the next message sent without a recorded sequence
+        std::vector<TraceEvent> events;     // Ring buffer of events
+        long long num_events = 0;           // Number of events recorded since tracing started
+
+    public:
+
+        void open(int trace_rank, long capacity);
+
+        void record(trace_kind kind, actor::id id, unsigned long long flow = 0);
+
+        static unsigned long long flow_id(int sender, long sequence, int sender_rank);
+
+        std::string format(long long origin_nanoseconds) const;
+    };
+}
+
+#endif
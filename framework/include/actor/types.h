@@ -1,9 +1,16 @@
 #ifndef TYPES_H
 #define TYPES_H
 
+#include <functional>
+
 namespace actor {
     // ID type for an actor
     typedef int id;
+
+    class Actor;
+
+    // Creates the actor object of a given ID
+    typedef std::function<Actor *(id)> constructor;
 }
 
 #endif
@@ -0,0 +1,53 @@
+#ifndef DIRECTORY_H
+#define DIRECTORY_H
+
+#include <vector>
+#include "mail/message.h"
+#include "actor/types.h"
+
+namespace mail {
+
+    /**
+     * Maps the ID of every actor in the framework to its mailbox address.
+     *
+     * Every MPI process holds a copy of the directory, so it is kept compact:
+     * - Actors placed in blocks of consecutive IDs and consecutive addresses are stored as a computed mapping,
+     *   which takes constant space per block regardless of the number of actors.
+     * - All other actors, as well as actors whose address changed, are stored in an array sorted by ID.
+     */
+    class Directory {
+    public:
+
+        /**
+         * Actors with IDs `first_id` to `first_id + count - 1`, which fill MPI processes with
+         * `actors_per_rank` actors each, starting at address (first_rank, first_tag).
+         */
+        struct Block {
+            actor::id first_id;
+            int count;
+            int first_rank;
+            int first_tag;
+            int actors_per_rank;
+
+            Address address(int i) const;
+        };
+
+        std::vector<Block> blocks;        // Computed mappings of actors placed in blocks
+        std::vector<actor::id> ids;       // Sorted IDs of actors stored explicitly
+        std::vector<Address> addresses;   // Addresses of actors stored explicitly, in the order of `ids`
+
+    public:
+
+        Directory();
+
+        void insert(actor::id id, Address address);
+
+        void insertInBlock(actor::id id, Address address, int actors_per_rank);
+
+        Address at(actor::id id) const;
+
+        int memoryUsage() const;
+    };
+}
+
+#endif
@@ -2,10 +2,12 @@
 #define MAILBOX_H
 
 #include <queue>
-#include <unordered_map>
+#include <vector>
 #include "mail/types.h"
 #include "mail/message.h"
+#include "mail/directory.h"
 #include "actor/types.h"
+#include "actor/trace.h"
 
 namespace mail {
 
@@ -15,7 +17,10 @@ namespace mail {
      */
     struct Context {
         std::vector<mail::Type> *mail_types;
-        std::unordered_map<actor::id, mail::Address> *id_to_address;
+        mail::Directory *id_to_address;
+        mail::Counters *counters;
+        std::vector<mail::Reduction> *reductions;
+        actor::Trace *trace;
     };
 
     /**
@@ -26,6 +31,8 @@ namespace mail {
     public:
         Address address{};  // An address uniquely identifying this mailbox
         Context context{};  // Holds pointers to data owned by the framework
+        Journal *journal = nullptr;  // When set, records sent messages (owned by the framework)
+        Outbox *outbox = nullptr;    // When set, buffers sent messages until the framework exchanges them
 
     public:
 
@@ -39,6 +46,10 @@ namespace mail {
 
         void send(Message &msg, actor::id to) const;
 
+        void reduce(Message &msg, actor::id to) const;
+
+        void cancel(const Sent &sent) const;
+
         ~Mailbox();
     };
 }
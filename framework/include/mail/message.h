@@ -32,6 +32,10 @@ namespace mail {
         void *data = NULL;
         int count = 0;
         MPI_Datatype mpi_datatype = MPI_DATATYPE_NULL;
+        double timestamp = 0;    // Logical time of the message, set by the sender
+        int sender = -1;         // ID of the sending actor, if recorded by the framework
+        long sequence = 0;       // Sequence number of the message, if recorded by the framework
+        bool anti = false;       // True if the message cancels the message of the same sender and sequence
 
         Message();
 
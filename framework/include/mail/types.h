@@ -1,16 +1,98 @@
 #ifndef TYPE_H
 #define TYPE_H
 
+#include <vector>
 #include "mpi.h"
 
 namespace mail {
 
+    // Appends the compact encoding of `count` data elements to the given bytes
+    typedef void (*encoder)(const void *data, int count, std::vector<char> &bytes);
+
+    // Reads `count` data elements back from `size` bytes written by the matching encoder
+    typedef void (*decoder)(const char *bytes, int size, void *data, int count);
+
     /**
      * Type supported by the framework's messaging system.
+     * When an encoder and decoder are provided, payloads of this type are sent as the encoded bytes rather than
+     * as the MPI datatype, e.g. to pack small fields into fewer bytes at high message rates.
      */
     struct Type {
         int size_bytes;
         MPI_Datatype mpi_datatype;
+        encoder encode = nullptr;
+        decoder decode = nullptr;
+    };
+
+    /**
+     * Metadata sent ahead of each payload.
+     */
+    struct Header {
+        int type_index;      // Index of the payload's data type in the list of registered types
+        int count;           // Number of data elements in the payload
+        double timestamp;    // Logical time of the message
+        int sender;          // ID of the sending actor when its sent messages are recorded, -1 otherwise
+        long sequence;       // Number of messages recorded by the sending actor before this message
+        int anti;            // 1 if this is an anti-message cancelling the recorded message of same sequence
+    };
+
+    /**
+     * Record of a message sent by an actor.
+     */
+    struct Sent {
+        int to;              // ID of the receiving actor
+        long sequence;       // Sequence number of the message
+        double timestamp;    // Logical time of the message
+        long batch;          // Batch of events of the sending actor that sent the message
+    };
+
+    /**
+     * Messages sent by an actor, recorded by the framework so that it can cancel them with anti-messages.
+     */
+    struct Journal {
+        int sender = -1;              // ID of the actor
+        long next_sequence = 0;       // Sequence number of the next message sent by the actor
+        long batch = 0;               // Batch of events the actor is currently processing
+        std::vector<Sent> sent;       // Messages sent by the actor which may still be cancelled
+    };
+
+    /**
+     * Messages sent by the actors of an MPI process, buffered until the framework exchanges them collectively.
+     * Each message is packed as its header, the tag of the receiving mailbox, the size of the packed payload
+     * and the payload packed via MPI_Pack, or encoded by the encoder of its type.
+     */
+    struct Outbox {
+        int sender = -1;                          // ID of the actor currently running
+        long next_sequence = 0;                   // Sequence number of the next buffered message
+        std::vector<std::vector<char>> buffers;   // Packed messages to each rank
+    };
+
+    /**
+     * Messages of a given type to a given actor, summed element by element across all actors before delivery.
+     * Each MPI process accumulates the messages of its actors, and the framework periodically reduces the sums
+     * of all MPI processes and delivers the total to the receiving actor as a single message.
+     */
+    struct Reduction {
+        int to;                  // ID of the receiving actor
+        int type_index;          // Index of the type of the messages, whose data elements consist of ints
+        std::vector<int> sum;    // Sum of the messages sent by actors of current MPI process since the last reduction
+    };
+
+    /**
+     * Number of messages sent and received by the actors of an MPI process.
+     */
+    struct Counters {
+        long sent = 0;
+        long received = 0;
+        std::vector<long> sent_to;         // Number of messages sent to each rank
+        std::vector<long> received_from;   // Number of messages received from each rank
+        std::vector<long> sent_by_type;    // Number of messages sent of each registered type
+        std::vector<long> received_by_type;       // Number of messages received of each registered type
+        std::vector<long> bytes_sent_by_type;     // Payload bytes sent of each registered type
+        std::vector<long> bytes_received_by_type; // Payload bytes received of each registered type
+        long bytes_sent = 0;               // Bytes of headers and payloads sent with MPI_Bsend, i.e. not via the outbox
+        long probes = 0;                   // Number of probes of mailboxes for a message
+        long probe_hits = 0;               // Number of probes that found a message
     };
 
 }
@@ -33,6 +33,89 @@ actor::next_step actor::Actor::ingress(mail::Message &message) {
     return actor::CONTINUE;
 }
 
+/**
+ * In logical time, returns the timestamp of the earliest event the actor has yet to process,
+ * taking into account the messages it has received. Returns NO_EVENT if there is no such event.
+ */
+double actor::Actor::next_event_time() {
+    return NO_EVENT;
+}
+
+/**
+ * In logical time, returns the minimum difference between the timestamp of a message sent by the actor
+ * and the timestamp of the event being processed when it is sent. The framework requires a positive lookahead.
+ */
+double actor::Actor::lookahead() {
+    return 0;
+}
+
+/**
+ * When synchronized by null messages, returns the IDs of the actors this actor sends timestamped messages to.
+ * Messages sent to other actors are processed by their receiver as they arrive, regardless of their timestamp.
+ */
+std::vector<actor::id> actor::Actor::channels() {
+    return {};
+}
+
+/**
+ * When synchronized by null messages, returns the lookahead of the messages sent to the given actor.
+ */
+double actor::Actor::channel_lookahead(actor::id to) {
+    return lookahead();
+}
+
+/**
+ * Write the state of the actor, so that it can be migrated to another MPI process, or rolled back in
+ * optimistic execution. Returns false if the actor does not support serialization, which is the default.
+ */
+bool actor::Actor::serialize(actor::Serializer &serializer) {
+    return false;
+}
+
+/**
+ * Restore the state of a migrated actor written by `serialize`.
+ * The actor object is created by the constructor callback given to the framework, and its initialization
+ * methods are not called again: this method must restore everything the actor needs to continue running.
+ * In optimistic execution, it is also called on a running actor to roll it back to an earlier state.
+ */
+bool actor::Actor::deserialize(actor::Deserializer &deserializer) {
+    return false;
+}
+
+/**
+ * Write the state of the actor to a checkpoint, from which a later run may resume. By default, the state
+ * written by `serialize`. Actors that must not be rolled back in optimistic execution, e.g. because they
+ * produce output, may support checkpoints by overriding this method rather than `serialize`.
+ */
+bool actor::Actor::checkpoint(actor::Serializer &serializer) {
+    return serialize(serializer);
+}
+
+/**
+ * Restore the state of the actor written by `checkpoint`, in place of its initialization methods.
+ * By default, via `deserialize`.
+ */
+bool actor::Actor::restore(actor::Deserializer &deserializer) {
+    return deserialize(deserializer);
+}
+
+/**
+ * Called once by the framework when the global stop reaches the MPI process of the actor (see
+ * `actor::Termination`). The actor may send its last messages, and stops unless it returns CONTINUE,
+ * in which case it must stop itself later. By default, the actor stops.
+ */
+actor::next_step actor::Actor::terminate() {
+    return actor::STOP;
+}
+
+/**
+ * With quiescence detection, returns false while the actor has work to do other than processing the messages
+ * it receives, e.g. work driven by the clock. By default, the actor only works in response to messages.
+ */
+bool actor::Actor::idle() {
+    return true;
+}
+
 void actor::Actor::finalize() {
     delete this;
 }
@@ -0,0 +1,32 @@
+#include "actor/counters.h"
+
+/**
+ * Provide the given number of counters, all starting at zero.
+ */
+void actor::ReplicatedCounters::resize(int num_counters) {
+    merged.assign(num_counters, 0);
+    pending.assign(num_counters, 0);
+    local.assign(num_counters, 0);
+}
+
+/**
+ * Returns the number of counters.
+ */
+int actor::ReplicatedCounters::size() const {
+    return static_cast<int>(merged.size());
+}
+
+/**
+ * Add the given value, which may be negative, to a counter.
+ */
+void actor::ReplicatedCounters::add(int counter, long value) {
+    local[counter] += value;
+}
+
+/**
+ * Returns the value of a counter: the increments merged from all MPI processes, along with the increments of
+ * current MPI process that are yet to be merged.
+ */
+long actor::ReplicatedCounters::get(int counter) const {
+    return merged[counter] + pending[counter] + local[counter];
+}
@@ -1,10 +1,26 @@
 #include <iostream>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <limits>
+#include <tuple>
 #include "mpi.h"
 #include "actor/actor.h"
 #include "mail/mailbox.h"
 #include "mail/message.h"
 #include "actor/framework.h"
 
+/**
+ * Returns the time on the monotonic clock in nanoseconds.
+ */
+static long long monotonic_nanoseconds() {
+    struct timespec time{};
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return time.tv_sec * NANOSECONDS_PER_SECOND + time.tv_nsec;
+}
+
 ParallelActorModel::ParallelActorModel(
         int num_actors_per_procs, bool ingress_mode, bool log_debug, int max_num_message_per_iteration)
         : num_actors_per_procs(num_actors_per_procs),
@@ -16,202 +32,2653 @@ ParallelActorModel::ParallelActorModel(
     MPI_Comm_rank(MPI_COMM_WORLD, &rank);
     MPI_Comm_size(MPI_COMM_WORLD, &num_procs);
     MPI_Buffer_attach(buffer, MPI_BUFFER_SIZE);
+    MPI_Comm_dup(MPI_COMM_WORLD, &framework_comm);
+    MPI_Comm_dup(MPI_COMM_WORLD, &reduction_comm);
+    epoch_request = MPI_REQUEST_NULL;
+    counters.sent_to.assign(num_procs, 0);
+    counters.received_from.assign(num_procs, 0);
     num_procs_for_grouped_actors = num_procs;
     grouped_actors_size = 0;
+    num_parts = 0;
+}
+
+/**
+ * Place grouped actors according to their communication graph, where vertex i of the graph is the actor with ID i.
+ * This method must be called before adding grouped actors.
+ *
+ * The graph is partitioned into as many parts as MPI processes block placement would use. Each part balances
+ * the vertex weights and the parts minimize the total weight of edges between different MPI processes.
+ * Consecutive ranks receive neighbouring regions of the graph, so that most remaining cut edges
+ * connect MPI processes on the same node.
+ */
+bool ParallelActorModel::setTopology(const placement::Graph &graph) {
+
+    if (!reserve_procs_for_placement(graph.size())) {
+        return false;
+    }
+
+    double start_time = MPI_Wtime();
+    actor_placement = placement::partition(graph, num_parts);
+    double end_time = MPI_Wtime();
+
+    if (log_debug && rank == 0) {
+        long total_edge_weight = 0;
+        for (const auto &weight: graph.adjwgt) {
+            total_edge_weight += weight;
+        }
+        printf("[DEBUG] Framework setTopology() takes %f seconds with %d of %ld edge weight cut\n",
+               end_time - start_time, placement::edge_cut(graph, actor_placement), total_edge_weight / 2);
+        fflush(stdout);
+    }
+    log_placement(graph.vwgt);
+
+    return true;
+}
+
+/**
+ * Place grouped actors such that the total weight per MPI process is balanced, where weights[i] is the
+ * computational load of the actor with ID i. This method must be called before adding grouped actors.
+ *
+ * Actors with consecutive IDs are assigned to the same or consecutive MPI processes.
+ */
+bool ParallelActorModel::setWeights(const std::vector<int> &weights) {
+
+    if (!reserve_procs_for_placement(static_cast<int>(weights.size()))) {
+        return false;
+    }
+
+    actor_placement = placement::blocks(weights, num_parts);
+    log_placement(weights);
+
+    return true;
 }
 
 /**
  * Add an actor to an MPI process that manages multiple actors.
+ * The actor object is destroyed if the actor is not handled by current process.
  */
 bool ParallelActorModel::addActor(actor::Actor *actor) {
 
+    auto is_local = false;
+    addActor(actor->id, [actor, &is_local](actor::id id) {
+        is_local = true;
+        return actor;
+    });
+
+    if (!is_local) {
+        actor->finalize();
+    }
+
+    return is_local;
+}
+
+/**
+ * Add an actor to an MPI process that manages multiple actors.
+ * The actor object is created by the given callback only if the actor is handled by current process,
+ * so that no MPI process creates the objects of actors handled by other processes.
+ * Returns true if the actor is handled by current process.
+ */
+bool ParallelActorModel::addActor(actor::id id, const actor::constructor &actor_constructor) {
+
     // Verify actor ID is unique
-    if (actors.find(actor->id) != actors.end()) {
-        fprintf(stderr, "ERROR: actor %d already exists!\n", actor->id);
+    if (actors.find(id) != actors.end()) {
+        fprintf(stderr, "ERROR: actor %d already exists!\n", id);
         return false;
     }
 
     // Verify availability of space for actor
-    if (grouped_actors_size == num_procs_for_grouped_actors * num_actors_per_procs) {
+    if (num_parts == 0 && grouped_actors_size == num_procs_for_grouped_actors * num_actors_per_procs) {
         fprintf(stderr, "ERROR: framework is full\n");
         return false;
     }
 
+    if (num_parts != 0 && (id < 0 || id >= actor_placement.size())) {
+        fprintf(stderr, "ERROR: actor %d is not part of the placement\n", id);
+        return false;
+    }
+
     // Assign an address to the new actor
-    auto actor_rank = grouped_actors_size / num_actors_per_procs;
-    auto actor_tag = grouped_actors_size % num_actors_per_procs;
-    auto address = mail::Address(actor_rank, actor_tag);
-    id_to_address[actor->id] = address;
+    auto address = assign_grouped_address(id);
+    if (num_parts == 0) {
+        id_to_address.insertInBlock(id, address, num_actors_per_procs);
+    } else {
+        id_to_address.insert(id, address);
+    }
     grouped_actors_size++;
 
-    // Check if this actor is handled by current process; destroy otherwise.
+    // Check if this actor is handled by current process
     if (address.rank != rank) {
-        actor->finalize();
         return false;
     }
 
-    // Current MPI process stores new actor
-    auto context = mail::Context{&mail_types, &id_to_address};
-    actor->mailbox = mail::Mailbox(address, context);
-    actors[actor->id] = actor;
+    // Current MPI process creates and stores new actor
+    store_actor(actor_constructor(id), address);
 
     return true;
 }
 
 /**
  * Add an actor to an MPI process that exclusively manages a single actor.
+ * The actor object is destroyed if the actor is not handled by current process.
  */
 bool ParallelActorModel::addIsolatedActor(actor::Actor *actor) {
 
+    auto is_local = false;
+    addIsolatedActor(actor->id, [actor, &is_local](actor::id id) {
+        is_local = true;
+        return actor;
+    });
+
+    if (!is_local) {
+        actor->finalize();
+    }
+
+    return is_local;
+}
+
+/**
+ * Add an actor to an MPI process that exclusively manages a single actor.
+ * The actor object is created by the given callback only if the actor is handled by current process.
+ * Returns true if the actor is handled by current process.
+ */
+bool ParallelActorModel::addIsolatedActor(actor::id id, const actor::constructor &actor_constructor) {
+
     // Verify actor ID is unique
-    if (actors.find(actor->id) != actors.end()) {
-        fprintf(stderr, "ERROR: actor %d already exists!\n", actor->id);
+    if (actors.find(id) != actors.end()) {
+        fprintf(stderr, "ERROR: actor %d already exists!\n", id);
         return false;
     }
 
     // Verify availability for an isolated actor
     auto available_isolated_actor_rank = num_procs_for_grouped_actors - 1;
-    auto available_group_actor_rank = grouped_actors_size / num_actors_per_procs;
-    if (available_isolated_actor_rank < available_group_actor_rank) {
-        fprintf(stderr, "ERROR: no available process for isolated actor.\n");
-        return false;
-    }
-
-    auto available_group_actor_rank_is_empty = (grouped_actors_size % num_actors_per_procs) == 0;
-    if (available_isolated_actor_rank == available_group_actor_rank && !available_group_actor_rank_is_empty) {
+    if (available_isolated_actor_rank < num_procs_in_use_by_grouped_actors()) {
         fprintf(stderr, "ERROR: no available process for isolated actor.\n");
         return false;
     }
 
     // Assign an address to the new actor
     auto address = mail::Address(available_isolated_actor_rank, 0);
-    id_to_address[actor->id] = address;
+    id_to_address.insert(id, address);
     num_procs_for_grouped_actors--;
 
-    // Check if this actor is handled by current process; destroy otherwise.
+    // Check if this actor is handled by current process
     if (address.rank != rank) {
-        actor->finalize();
         return false;
     }
 
-    // Current MPI process stores new actor
-    auto context = mail::Context{&mail_types, &id_to_address};
+    // Current MPI process creates and stores new actor
+    store_actor(actor_constructor(id), address);
+
+    return true;
+}
+
+/**
+ * Store an actor handled by current MPI process and give it a mailbox with the given address.
+ */
+void ParallelActorModel::store_actor(actor::Actor *actor, mail::Address address) {
+    auto context = mail::Context{&mail_types, &id_to_address, &counters, &reductions, &trace};
     actor->mailbox = mail::Mailbox(address, context);
+    actor->counters = counters_replica.size() > 0 ? &counters_replica : nullptr;
+    actor->output = output_filename.empty() ? nullptr : &output;
+    actor->snapshots = snapshots.file == nullptr ? nullptr : &snapshots;
+    actor->termination = termination_mode ? &termination : nullptr;
     actors[actor->id] = actor;
+}
+
+/**
+ * Reserve MPI processes for a placement of grouped actors.
+ * As many MPI processes are reserved as block placement would use for the given number of actors.
+ */
+bool ParallelActorModel::reserve_procs_for_placement(int num_actors) {
+
+    if (grouped_actors_size != 0) {
+        fprintf(stderr, "ERROR: placement must be set before adding grouped actors\n");
+        return false;
+    }
+
+    // Verify availability of space for actors
+    auto required_procs = (num_actors + num_actors_per_procs - 1) / num_actors_per_procs;
+    if (required_procs > num_procs_for_grouped_actors) {
+        fprintf(stderr, "ERROR: framework is full\n");
+        return false;
+    }
 
+    num_parts = required_procs;
+    num_actors_by_rank = std::vector<int>(num_parts, 0);
     return true;
 }
 
+/**
+ * Print the maximum and average weight per MPI process of the placement when the log level is set to debug.
+ */
+void ParallelActorModel::log_placement(const std::vector<int> &weights) {
+
+    if (!log_debug || rank != 0 || num_parts == 0) {
+        return;
+    }
+
+    long total_weight = 0;
+    std::vector<long> weight_by_rank(num_parts, 0);
+    for (int i = 0; i < weights.size(); i++) {
+        weight_by_rank[actor_placement[i]] += weights[i];
+        total_weight += weights[i];
+    }
+
+    long max_weight = 0;
+    for (const auto &weight: weight_by_rank) {
+        max_weight = std::max(max_weight, weight);
+    }
+
+    printf("[DEBUG] Framework placement has maximum weight %ld and average weight %f per process\n",
+           max_weight, static_cast<double>(total_weight) / num_parts);
+    fflush(stdout);
+}
+
+/**
+ * Assign the mailbox address of a new grouped actor.
+ * Without a placement, actors fill up MPI processes in the order they are added.
+ */
+mail::Address ParallelActorModel::assign_grouped_address(actor::id id) {
+
+    if (num_parts == 0) {
+        auto actor_rank = grouped_actors_size / num_actors_per_procs;
+        auto actor_tag = grouped_actors_size % num_actors_per_procs;
+        return mail::Address(actor_rank, actor_tag);
+    }
+
+    auto actor_rank = actor_placement[id];
+    auto actor_tag = num_actors_by_rank[actor_rank]++;
+    return mail::Address(actor_rank, actor_tag);
+}
+
+/**
+ * Returns the number of MPI processes (starting at rank 0) that are used, or reserved, for grouped actors.
+ */
+int ParallelActorModel::num_procs_in_use_by_grouped_actors() const {
+    if (num_parts != 0) {
+        return num_parts;
+    }
+    return (grouped_actors_size + num_actors_per_procs - 1) / num_actors_per_procs;
+}
+
 /**
  * Register a data type for actors to use as a payload in their message exchanges.
  */
 void ParallelActorModel::addType(mail::Type type) {
     mail_types.push_back(type);
+    counters.sent_by_type.push_back(0);
+    counters.received_by_type.push_back(0);
+    counters.bytes_sent_by_type.push_back(0);
+    counters.bytes_received_by_type.push_back(0);
+}
+
+/**
+ * Reduce the messages of the given registered type sent to the given actor: the framework sums them element
+ * by element, across all actors of all MPI processes, and periodically delivers the total to the actor as a
+ * single message (see `reduce_messages` method). Actors send such messages via the `reduce` method of their
+ * mailbox. The data elements of the type must consist of ints, and the receiving actor should not migrate.
+ * Reductions only apply in real time. This method must be called on all MPI processes before calling `start`.
+ */
+bool ParallelActorModel::addReduction(actor::id to, MPI_Datatype mpi_datatype) {
+
+    for (int i = 0; i < mail_types.size(); i++) {
+        if (mail_types[i].mpi_datatype == mpi_datatype) {
+            if (mail_types[i].size_bytes % sizeof(int) != 0) {
+                fprintf(stderr, "ERROR: reduced data type must consist of ints\n");
+                return false;
+            }
+            auto size = mail_types[i].size_bytes / sizeof(int);
+            reductions.push_back(mail::Reduction{to, i, std::vector<int>(size, 0)});
+            return true;
+        }
+    }
+
+    fprintf(stderr, "ERROR: reduced data type must be registered first\n");
+    return false;
+}
+
+/**
+ * Provide the given number of counters, replicated on all MPI processes, to all actors via their `counters`
+ * member (see `actor::ReplicatedCounters`). Actors identify a counter by its index. Counters only apply in
+ * real time. This method must be called on all MPI processes before calling `start`.
+ */
+void ParallelActorModel::enableCounters(int num_counters) {
+    counters_replica.resize(num_counters);
+}
+
+/**
+ * Let actors write records to the given file via their `output` member (see `actor::Output`). Once all actors
+ * stopped, all MPI processes write their records to the file collectively (see `write_output` method).
+ * If a chunk format is given, the records of each MPI process are written as one chunk in that format.
+ * This method must be called on all MPI processes before calling `start`.
+ */
+void ParallelActorModel::enableOutput(const std::string &filename, actor::chunk_format format) {
+    output_filename = filename;
+    output.format = format;
+}
+
+/**
+ * Let actors stream records via their `snapshots` member (see `actor::Snapshots`) to a file per MPI process,
+ * named after the given prefix and the rank, while they run. Snapshots do not apply in optimistic execution.
+ * This method must be called on all MPI processes before calling `start`.
+ */
+void ParallelActorModel::enableSnapshots(const std::string &prefix) {
+    snapshots_prefix = prefix;
+}
+
+/**
+ * Let actors request the global stop of all actors via their `termination` member (see `actor::Termination`),
+ * and, with quiescence detection, stop all actors once no work remains. Global termination only applies in
+ * real time. This method must be called on all MPI processes before calling `start`.
+ */
+void ParallelActorModel::enableTermination(bool quiescence) {
+    termination_mode = true;
+    termination.quiescence = quiescence;
+}
+
+/**
+ * Write a checkpoint of all actors to the given file about every given number of seconds or, with migration,
+ * in the first load balancing epoch after that (see `write_checkpoint` method). Actors must support checkpoints via their `checkpoint` method. Checkpoints
+ * only apply in real time. This method must be called on all MPI processes before calling `start`.
+ */
+void ParallelActorModel::enableCheckpoints(const std::string &filename, double interval_seconds) {
+    checkpoint_filename = filename;
+    checkpoint_epochs = std::max(1L, std::lround(interval_seconds / REDUCTION_INTERVAL));
+}
+
+/**
+ * Resume actors from the given checkpoint file rather than initializing them (see `restore_checkpoint`
+ * method). Every actor must still be added to the framework, as in the run that wrote the checkpoint, but
+ * possibly on a different number of MPI processes. This method must be called on all MPI processes before
+ * calling `start`.
+ */
+void ParallelActorModel::restoreCheckpoint(const std::string &filename) {
+    restore_filename = filename;
+}
+
+/**
+ * Measure the time spent in each actor and the execution cycles of each MPI process, and write them along with
+ * the message counters of the MPI process to a JSON file named after the given prefix and the rank once all
+ * actors stopped (see `write_profile` method). This method must be called on all MPI processes before calling
+ * `start`.
+ */
+void ParallelActorModel::enableProfiling(const std::string &prefix) {
+    profile_prefix = prefix;
+    profile.enabled = true;
+    instrumented = true;
+}
+
+/**
+ * Record when each actor processes messages and runs, and when messages are sent and received, into a ring
+ * buffer of the given number of events per MPI process (see `actor::Trace`). Once all actors stopped, the
+ * events of all MPI processes are written to the given file in the Chrome trace event format (see
+ * `write_trace` method). This method must be called on all MPI processes before calling `start`.
+ */
+void ParallelActorModel::enableTracing(const std::string &filename, long capacity) {
+    trace_filename = filename;
+    trace.open(rank, capacity);
+    instrumented = true;
+}
+
+/**
+ * Allow grouped actors to migrate between MPI processes to balance their load.
+ * The given callback creates the actor object of an actor migrating to current MPI process,
+ * whose state is then restored with its `deserialize` method. Only actors whose `serialize` method
+ * succeeds are migrated. This method must be called on all MPI processes before calling `start`.
+ */
+void ParallelActorModel::enableMigration(actor::constructor actor_constructor) {
+    migration_mode = true;
+    constructor = actor_constructor;
+}
+
+/**
+ * Select the time mode of the execution cycle. This method must be called on all MPI processes before
+ * calling `start`, which tells every actor the time mode via its clock before initializing it.
+ * Logical time modes require the ingress mode.
+ */
+void ParallelActorModel::setTimeMode(actor::time_mode mode) {
+    time_mode = mode;
 }
 
 /**
  * Run the actor model execution cycle.
  *
- * (1) Initialize all actors (see `initialize_actors` method)
- * (2) For each actor
- *     - Receive and process messages via its `ingress` method
- *     - Call its `run` method
- *     - Upon termination, remove an actor from the execution cycle.
+ * (1) Initialize all actors (see `initialize_actors` method), or restore them from a checkpoint (see
+ *     `restore_checkpoint` method)
+ * (2) Run actors in real time (see `run_real_time` method) or in logical time (see `run_windowed`,
+ *     `run_null_messages`, `run_optimistic` and `run_bsp` methods).
+ * (3) Write the records of all actors to the output file, if enabled (see `write_output` method).
  */
 void ParallelActorModel::start() {
 
-    auto success = initialize_actors();
+    // Records streamed while running are lost on rollback, so optimistic execution takes no snapshots
+    if (!snapshots_prefix.empty() && time_mode != actor::OPTIMISTIC) {
+        auto filename = snapshots_prefix + "." + std::to_string(rank);
+        if (!snapshots.open(filename)) {
+            fprintf(stderr, "ERROR: failed to open %s\n", filename.c_str());
+        }
+    }
+
+    // In bulk synchronous execution, messages sent from initialization onwards are exchanged collectively
+    outbox.buffers.resize(num_procs);
+    for (const auto &kv: actors) {
+        kv.second->clock.mode = time_mode;
+        kv.second->mailbox.outbox = time_mode == actor::BSP ? &outbox : nullptr;
+        kv.second->counters = counters_replica.size() > 0 ? &counters_replica : nullptr;
+        kv.second->output = output_filename.empty() ? nullptr : &output;
+        kv.second->snapshots = snapshots.file == nullptr ? nullptr : &snapshots;
+        kv.second->termination = termination_mode ? &termination : nullptr;
+    }
+
+    if (time_mode != actor::REAL_TIME && !restore_filename.empty()) {
+        fprintf(stderr, "ERROR: checkpoints only apply in real time\n");
+        return;
+    }
+    if (time_mode != actor::REAL_TIME && !ingress_mode) {
+        fprintf(stderr, "ERROR: logical time requires the ingress mode\n");
+        return;
+    }
+    if (time_mode != actor::REAL_TIME) {
+        checkpoint_filename.clear();
+    }
+
+    auto success = restore_filename.empty() ? initialize_actors() : restore_checkpoint();
+    profile.start_nanoseconds = monotonic_nanoseconds();
     if (!success) {
         fprintf(stderr, "failed to initialize all actors.\n");
         return;
     }
 
-    while (!actors.empty()) {
-
-        // Maintain a list of stopped actors
-        std::vector<actor::id> stopped_actors;
+    if (time_mode != actor::REAL_TIME && migration_mode && log_debug && rank == 0) {
+        printf("[DEBUG] Framework migration is disabled in logical time\n");
+        fflush(stdout);
+    }
 
-        // Run actors
+    // In logical time, messages are delivered as sent, with their timestamp, and actors share no counters
+    // nor global stop
+    if (time_mode != actor::REAL_TIME) {
+        reductions.clear();
+        termination_mode = false;
         for (const auto &kv: actors) {
+            kv.second->counters = nullptr;
+            kv.second->termination = nullptr;
+        }
+    }
+    reduction_mode = time_mode == actor::REAL_TIME && (!reductions.empty() || counters_replica.size() > 0
+                                                       || termination_mode || !checkpoint_filename.empty());
 
-            auto id = kv.first;
-            auto next_step = actor::CONTINUE;
+    if (time_mode == actor::REAL_TIME) {
+        run_real_time();
+    } else if (time_mode == actor::WINDOWED) {
+        run_windowed();
+    } else if (time_mode == actor::NULL_MESSAGES) {
+        run_null_messages();
+    } else if (time_mode == actor::OPTIMISTIC) {
+        run_optimistic();
+    } else {
+        run_bsp();
+    }
 
-            // Actor receives and process messages via the `ingress` method
-            if (ingress_mode) {
-                int messages = 0;
-                while (next_step == actor::CONTINUE
-                       && actors[id]->mailbox.hasMessage()
-                       && messages < max_num_message_per_iteration) {
-                    auto message = actors[id]->mailbox.receive();
-                    next_step = actors[id]->ingress(message);
-                    message.discard();
-                    messages++;
-                }
-            }
+    snapshots.close();
 
-            // Actor calls the `run` method
-            if (next_step == actor::CONTINUE) {
-                next_step = actors[id]->run();
-            }
+    if (profile.enabled) {
+        write_profile();
+    }
 
-            // Keep track of stopped actors
-            if (next_step == actor::STOP) {
-                stopped_actors.push_back(id);
-            }
-        }
+    if (trace.enabled && !write_trace()) {
+        fprintf(stderr, "ERROR: failed to write %s\n", trace_filename.c_str());
+    }
 
-        // Remove stopped actors from execution cycle
-        finalize_actors(stopped_actors);
+    if (!output_filename.empty() && !write_output()) {
+        fprintf(stderr, "ERROR: failed to write %s\n", output_filename.c_str());
     }
 }
 
 /**
- * Initialize the actors by executing the following steps in sequence:
+ * Write the profile of current MPI process to its profile file, and print a summary across all MPI processes
+ * on rank 0:
  *
- * (1) For each actor, execute their `pre_barrier_init` methods.
- * (2) Wait for all actors to complete the execution of their `pre_barrier_init`.
- * (3) For each actor, execute their `post_barrier_init` methods.
+ * (1) Each MPI process writes the time spent in each of its actors, its rate of execution cycles, and its
+ *     messages and bytes sent and received by type to `<prefix>.<rank>.json` (see `actor::Profile`).
+ * (2) All MPI processes reduce their totals to rank 0, which prints the time spent in `ingress` and `run`,
+ *     the range of rates of execution cycles, the probe hit rate, the largest number of bytes sent with MPI_Bsend
+ *     in one execution cycle against the size of the attached buffer, and the messages and bytes by type.
  */
-bool ParallelActorModel::initialize_actors() {
+void ParallelActorModel::write_profile() {
 
-    double start_time = MPI_Wtime();
+    profile.end_nanoseconds = monotonic_nanoseconds();
+    auto filename = profile_prefix + "." + std::to_string(rank) + ".json";
+    if (!profile.write(filename, rank, counters)) {
+        fprintf(stderr, "ERROR: failed to write %s\n", filename.c_str());
+    }
 
-    // Run `pre_barrier_init` for each actor
-    for (const auto &kv: actors) {
-        auto success = kv.second->pre_barrier_init();
-        if (!success) {
-            return false;
-        }
+    // Totals of current MPI process: ingress and run nanoseconds, actors backlogged, probes, probe hits
+    long local_sums[5] = {0, 0, 0, counters.probes, counters.probe_hits};
+    for (const auto &kv: profile.actors) {
+        local_sums[0] += kv.second.ingress_nanoseconds;
+        local_sums[1] += kv.second.run_nanoseconds;
+        local_sums[2] += kv.second.backlogged_cycles > 0 ? 1 : 0;
     }
+    long sums[5];
+    MPI_Reduce(local_sums, sums, 5, MPI_LONG, MPI_SUM, 0, framework_comm);
 
-    // Wait for all actors to finish initialization
-    MPI_Barrier(MPI_COMM_WORLD);
+    auto seconds = profile.seconds();
+    double rate = seconds > 0 ? static_cast<double>(profile.cycles) / seconds : 0;
+    double local_rates[2] = {rate, -rate};
+    double rates[2];
+    MPI_Reduce(local_rates, rates, 2, MPI_DOUBLE, MPI_MIN, 0, framework_comm);
 
-    // Run `post_barrier_init` for each actor
-    for (const auto &kv: actors) {
-        auto success = kv.second->post_barrier_init();
-        if (!success) {
-            return false;
-        }
+    long max_cycle_bytes = 0;
+    MPI_Reduce(&profile.max_cycle_bytes, &max_cycle_bytes, 1, MPI_LONG, MPI_MAX, 0, framework_comm);
+
+    // Messages and bytes sent and received by type
+    auto num_types = static_cast<int>(mail_types.size());
+    std::vector<long> local_types;
+    for (const auto *by_type: {&counters.sent_by_type, &counters.bytes_sent_by_type, &counters.received_by_type,
+                               &counters.bytes_received_by_type}) {
+        local_types.insert(local_types.end(), by_type->begin(), by_type->end());
     }
+    std::vector<long> types(local_types.size());
+    MPI_Reduce(local_types.data(), types.data(), static_cast<int>(local_types.size()), MPI_LONG, MPI_SUM, 0,
+               framework_comm);
 
-    double end_time = MPI_Wtime();
-    if (log_debug && rank == 0) {
-        printf("[DEBUG] Framework initialize_actors() takes %f seconds\n", end_time - start_time);
-        fflush(stdout);
+    if (rank != 0) {
+        return;
     }
 
-    return true;
+    printf("[PROFILE] %d processes, %f seconds in ingress, %f seconds in run, %ld actors backlogged\n", num_procs,
+           static_cast<double>(sums[0]) / NANOSECONDS_PER_SECOND, static_cast<double>(sums[1]) / NANOSECONDS_PER_SECOND,
+           sums[2]);
+    printf("[PROFILE] %f to %f execution cycles per second, %ld probes with %f%% hits\n", rates[0], -rates[1],
+           sums[3], sums[3] > 0 ? 100.0 * static_cast<double>(sums[4]) / static_cast<double>(sums[3]) : 0.0);
+    printf("[PROFILE] At most %ld bytes sent with MPI_Bsend in one execution cycle, of %d bytes buffered\n",
+           max_cycle_bytes, MPI_BUFFER_SIZE);
+    for (int i = 0; i < num_types; i++) {
+        printf("[PROFILE] Type %d: %ld messages sent (%ld bytes), %ld messages received (%ld bytes)\n", i, types[i],
+               types[num_types + i], types[2 * num_types + i], types[3 * num_types + i]);
+    }
+    fflush(stdout);
 }
 
 /**
- * Remove actors from the execution cycle that have terminated.
+ * Write the events recorded by all MPI processes to the trace file, as a single Chrome trace with one process per
+ * rank, with collective MPI-IO (see `write_records` method). Timestamps are in microseconds since actors started,
+ * which all MPI processes share since actors start after a barrier.
  */
-void ParallelActorModel::finalize_actors(std::vector<actor::id> &stopped_actors) {
-    for (const auto &id: stopped_actors) {
-        auto actor = actors[id];
-        actors.erase(id);
-        actor->finalize();
+bool ParallelActorModel::write_trace() {
+
+    trace.enabled = false;
+    std::map<long, std::string> records;
+    records[rank] = (rank == 0 ? "" : ",\n") + trace.format(start_nanoseconds);
+    if (rank == 0) {
+        records[-1] = "{\"displayTimeUnit\": \"ns\", \"traceEvents\": [\n";
+        records[num_procs] = "\n]}\n";
+    }
+
+    return write_records(trace_filename, records, framework_comm);
+}
+
+/**
+ * Write the records of the actors of all MPI processes to the output file, ordered by key, with collective
+ * MPI-IO (see `write_records` method):
+ *
+ * (1) A distributed prefix sum over the sizes of the records, in order of key, gives each MPI process the
+ *     offset of each of its records in the file.
+ * (2) Each MPI process describes its records as blocks at these offsets in a file view, and writes all its
+ *     records in a single collective write, so that no MPI process gathers the records of others.
+ *
+ * With a chunk format, the records of each MPI process are first merged into a single record keyed by rank.
+ */
+bool ParallelActorModel::write_output() {
+
+    if (output.format != nullptr) {
+        auto chunk = output.format(output.records);
+        output.records.clear();
+        output.records[rank] = chunk;
+    }
+
+    auto success = write_records(output_filename, output.records, framework_comm);
+    output.records.clear();
+
+    return success;
+}
+
+/**
+ * Write the given records of all MPI processes of the given communicator to a file, ordered by key, with
+ * collective MPI-IO. If `index` is given, the key and size of all records, in order of key, are appended to it
+ * on the first MPI process.
+ *
+ * The offsets of records are computed by a distributed prefix sum, so that no MPI process handles the keys of all
+ * records: each MPI process owns a contiguous range of keys, receives the key and size of the records in its range,
+ * and sends back their offsets, from the sum of the sizes in the ranges of the preceding MPI processes.
+ */
+bool ParallelActorModel::write_records(const std::string &filename, const std::map<long, std::string> &records,
+                                       MPI_Comm comm, std::vector<long> *index) {
+
+    std::string data;
+    for (const auto &kv: records) {
+        data += kv.second;
+    }
+
+    // Split the range of keys of all MPI processes evenly between them
+    long bounds[2] = {std::numeric_limits<long>::max(), std::numeric_limits<long>::max()};
+    if (!records.empty()) {
+        bounds[0] = records.begin()->first;
+        bounds[1] = -records.rbegin()->first;
+    }
+    MPI_Allreduce(MPI_IN_PLACE, bounds, 2, MPI_LONG, MPI_MIN, comm);
+    auto min_key = bounds[0];
+    auto num_keys = static_cast<double>(-bounds[1]) - static_cast<double>(min_key) + 1;
+    auto owner = [min_key, num_keys, this](long key) {
+        auto r = static_cast<int>((static_cast<double>(key) - static_cast<double>(min_key)) * num_procs / num_keys);
+        return std::min(std::max(r, 0), num_procs - 1);
+    };
+
+    // Send the key and size of local records to their owners, which are in increasing order of key
+    std::vector<long> local;
+    std::vector<int> send_counts(num_procs, 0);
+    for (const auto &kv: records) {
+        local.push_back(kv.first);
+        local.push_back(static_cast<long>(kv.second.size()));
+        send_counts[owner(kv.first)] += 2;
+    }
+
+    std::vector<int> receive_counts(num_procs);
+    MPI_Alltoall(send_counts.data(), 1, MPI_INT, receive_counts.data(), 1, MPI_INT, comm);
+
+    std::vector<int> send_displacements(num_procs, 0), receive_displacements(num_procs, 0);
+    for (int r = 1; r < num_procs; r++) {
+        send_displacements[r] = send_displacements[r - 1] + send_counts[r - 1];
+        receive_displacements[r] = receive_displacements[r - 1] + receive_counts[r - 1];
+    }
+
+    std::vector<long> owned(receive_displacements.back() + receive_counts.back());
+    MPI_Alltoallv(local.data(), send_counts.data(), send_displacements.data(), MPI_LONG, owned.data(),
+                  receive_counts.data(), receive_displacements.data(), MPI_LONG, comm);
+
+    // Prefix sum of the sizes of owned records in order of key, preceded by those of the preceding MPI processes
+    auto num_owned = static_cast<int>(owned.size() / 2);
+    std::vector<int> order(num_owned);
+    for (int i = 0; i < num_owned; i++) {
+        order[i] = i;
+    }
+    std::sort(order.begin(), order.end(), [&owned](int a, int b) {
+        return owned[2 * a] < owned[2 * b];
+    });
+
+    long owned_size = 0;
+    for (int i = 0; i < num_owned; i++) {
+        owned_size += owned[2 * i + 1];
+    }
+    long base = 0;
+    MPI_Exscan(&owned_size, &base, 1, MPI_LONG, MPI_SUM, comm);
+    if (rank == 0) {
+        base = 0;
+    }
+
+    long file_size;
+    MPI_Allreduce(&owned_size, &file_size, 1, MPI_LONG, MPI_SUM, comm);
+
+    std::vector<long> owned_offsets(num_owned);
+    std::vector<long> owned_index;
+    for (const auto &i: order) {
+        owned_offsets[i] = base;
+        base += owned[2 * i + 1];
+        if (index != nullptr) {
+            owned_index.push_back(owned[2 * i]);
+            owned_index.push_back(owned[2 * i + 1]);
+        }
+    }
+
+    // Return the offsets to the MPI processes of the records
+    for (int r = 0; r < num_procs; r++) {
+        send_counts[r] /= 2;
+        send_displacements[r] /= 2;
+        receive_counts[r] /= 2;
+        receive_displacements[r] /= 2;
+    }
+    std::vector<long> offsets(records.size());
+    MPI_Alltoallv(owned_offsets.data(), receive_counts.data(), receive_displacements.data(), MPI_LONG,
+                  offsets.data(), send_counts.data(), send_displacements.data(), MPI_LONG, comm);
+
+    // The first MPI process gathers the index, in order of key since MPI processes own increasing ranges of keys
+    if (index != nullptr) {
+        auto count = static_cast<int>(owned_index.size());
+        std::vector<int> counts(num_procs);
+        MPI_Gather(&count, 1, MPI_INT, counts.data(), 1, MPI_INT, 0, comm);
+
+        std::vector<int> displacements(num_procs, 0);
+        for (int r = 1; r < num_procs; r++) {
+            displacements[r] = displacements[r - 1] + counts[r - 1];
+        }
+
+        auto start = index->size();
+        if (rank == 0) {
+            index->resize(start + displacements.back() + counts.back());
+        }
+        MPI_Gatherv(owned_index.data(), count, MPI_LONG, rank == 0 ? index->data() + start : nullptr,
+                    counts.data(), displacements.data(), MPI_LONG, 0, comm);
+    }
+
+    // Local records are blocks of the file view, in increasing order of offset
+    std::vector<int> block_lengths;
+    std::vector<MPI_Aint> block_displacements;
+    int i = 0;
+    for (const auto &kv: records) {
+        block_lengths.push_back(static_cast<int>(kv.second.size()));
+        block_displacements.push_back(offsets[i++]);
+    }
+
+    MPI_Datatype file_type;
+    MPI_Type_create_hindexed(static_cast<int>(block_lengths.size()), block_lengths.data(),
+                             block_displacements.data(), MPI_BYTE, &file_type);
+    MPI_Type_commit(&file_type);
+
+    MPI_File file;
+    auto error = MPI_File_open(comm, filename.c_str(), MPI_MODE_CREATE | MPI_MODE_WRONLY, MPI_INFO_NULL, &file);
+    if (error != MPI_SUCCESS) {
+        MPI_Type_free(&file_type);
+        return false;
+    }
+
+    MPI_File_set_size(file, file_size);
+    MPI_File_set_view(file, 0, MPI_BYTE, file_type, "native", MPI_INFO_NULL);
+    error = MPI_File_write_at_all(file, 0, data.data(), static_cast<int>(data.size()), MPI_BYTE,
+                                  MPI_STATUS_IGNORE);
+    MPI_File_close(&file);
+    MPI_Type_free(&file_type);
+
+    return error == MPI_SUCCESS;
+}
+
+/**
+ * Run the execution cycle in real time:
+ *
+ * (1) For each actor
+ *     - Update its wall time, read from the monotonic clock once per execution cycle
+ *     - Receive and process messages via its `ingress` method
+ *     - Call its `run` method
+ *     - Upon termination, remove an actor from the execution cycle.
+ * (2) When migration is enabled, forward messages of actors that migrated away and balance load
+ *     (see `balance_load` method). The execution cycle then ends once all actors of all MPI processes stopped.
+ * (3) Reduce the messages of local actors to their receiving actors and merge replicated counters
+ *     (see `reduce_messages` method), until the actors of all MPI processes stopped.
+ */
+void ParallelActorModel::run_real_time() {
+
+    // Tags of migrating actors must not clash with tags of local actors
+    for (const auto &kv: actors) {
+        next_tag = std::max(next_tag, kv.second->mailbox.address.tag + 1);
+        actor_load[kv.first] = 0;
+    }
+    last_epoch_time = MPI_Wtime();
+
+    while (!actors.empty() || migration_mode) {
+
+        // Maintain a list of stopped actors
+        std::vector<actor::id> stopped_actors;
+
+        // Read the clock once for all actors
+        auto wall_time = monotonic_nanoseconds() - start_nanoseconds;
+
+        // Run actors
+        for (const auto &kv: actors) {
+
+            auto id = kv.first;
+            double start_time = migration_mode ? MPI_Wtime() : 0;
+            kv.second->clock.wall_time = wall_time;
+
+            // Actor receives and process messages via the `ingress` method
+            auto next_step = receive_messages(kv.second, max_num_message_per_iteration);
+
+            // Actor calls the `run` method
+            if (next_step == actor::CONTINUE) {
+                next_step = run(actors[id]);
+            }
+
+            // Keep track of time spent in actor
+            if (migration_mode) {
+                actor_load[id] += MPI_Wtime() - start_time;
+            }
+
+            // Keep track of stopped actors
+            if (next_step == actor::STOP) {
+                stopped_actors.push_back(id);
+            }
+        }
+
+        // Remove stopped actors from execution cycle
+        finalize_actors(stopped_actors);
+
+        // Hand records streamed by actors over to the snapshot writer
+        snapshots.flush();
+        profile.count_cycle(counters);
+
+        // Reduce messages to their receiving actors, merge replicated counters and detect the global stop
+        reduce_messages();
+        terminate_actors();
+
+        // Migrate actors between MPI processes
+        if (migration_mode) {
+            num_sweeps++;
+            forward_messages();
+            if (!balance_load()) {
+                break;
+            }
+        }
+    }
+
+    // Take part in reductions until all MPI processes stopped
+    while (reduce_messages()) {}
+}
+
+/**
+ * Reduce the messages sent by local actors via the `reduce` method of their mailbox, and merge the increments
+ * of replicated counters, in epochs of REDUCTION_INTERVAL seconds:
+ *
+ * (1) Each MPI process contributes the sums of the messages of its actors and the increments of its counters
+ *     since the last epoch, along with whether it still has actors, to a non-blocking all-reduce.
+ * (2) Once the all-reduce completes, the MPI process of each receiving actor delivers the non-zero total to it,
+ *     so that it receives one message per epoch, rather than one message per sending actor. Every MPI process
+ *     adds the increments of all MPI processes to its replica of the counters.
+ *
+ * With global termination, each MPI process also contributes whether one of its actors requested the global
+ * stop and, for quiescence detection, its number of busy actors and of messages sent and received. Since all
+ * MPI processes get the same totals, they all detect the global stop in the same epoch.
+ *
+ * With checkpoints, every `checkpoint_epochs` epochs, all MPI processes write a checkpoint between the completed
+ * epoch and the next one (see `write_checkpoint` method). With migration, MPI processes may be blocked in a load
+ * balancing epoch meanwhile, so the checkpoint is written in the next load balancing epoch instead (see
+ * `balance_load` method).
+ *
+ * Since every MPI process must take part in every epoch, an MPI process keeps starting epochs after its actors
+ * stopped. Returns false once an epoch completed in which no MPI process had actors left.
+ */
+bool ParallelActorModel::reduce_messages() {
+
+    if (!reduction_mode) {
+        return false;
+    }
+
+    // Complete pending epoch
+    if (reduction_request != MPI_REQUEST_NULL) {
+        int flag = 0;
+        MPI_Test(&reduction_request, &flag, MPI_STATUS_IGNORE);
+        if (!flag) {
+            return true;
+        }
+        if (!complete_reduction()) {
+            return false;
+        }
+    }
+
+    // Start next epoch
+    if (!actors.empty() && MPI_Wtime() - last_reduction_time < REDUCTION_INTERVAL) {
+        return true;
+    }
+
+    start_reduction();
+    return true;
+}
+
+/**
+ * Deliver the totals of the completed reduction epoch to the receiving actors of current MPI process, merge the
+ * increments of the counters and detect the global stop (see `reduce_messages` method).
+ * Returns false if no MPI process had actors left in the epoch.
+ */
+bool ParallelActorModel::complete_reduction() {
+
+    auto offset = reduction_result.begin();
+    for (const auto &reduction: reductions) {
+        std::vector<int> total(offset, offset + static_cast<long>(reduction.sum.size()));
+        offset += static_cast<long>(reduction.sum.size());
+
+        auto receiver = actors.find(reduction.to);
+        if (receiver == actors.end() || std::all_of(total.begin(), total.end(), [](int v) { return v == 0; })) {
+            continue;
+        }
+        auto message = mail::Message(total.data(), 1, mail_types[reduction.type_index].mpi_datatype);
+        receiver->second->mailbox.send(message, reduction.to);
+    }
+
+    for (int i = 0; i < counters_replica.size(); i++) {
+        counters_replica.merged[i] += *offset++;
+        counters_replica.pending[i] = 0;
+    }
+
+    if (termination_mode) {
+        auto requested = offset[0];
+        auto busy = offset[1];
+        auto sent = offset[2];
+        auto received = offset[3];
+        auto quiescent = termination.quiescence && busy == 0 && sent == received;
+        if (requested > 0 || (quiescent && sent == termination.last_sent)) {
+            termination.stopping = true;
+        }
+        termination.last_sent = quiescent ? sent : -1;
+    }
+
+    // No more epochs once all actors stopped
+    if (reduction_result.back() == 0) {
+        reduction_mode = false;
+        return false;
+    }
+
+    // Every MPI process completes the same epochs, so they all write checkpoints in the same epochs
+    num_epochs++;
+    if (!checkpoint_filename.empty() && num_epochs % checkpoint_epochs == 0 && !termination.stopping) {
+        if (migration_mode) {
+            checkpoint_due = true;
+        } else {
+            write_checkpoint(reduction_comm);
+        }
+    }
+
+    return true;
+}
+
+/**
+ * Start the next reduction epoch with the contribution of current MPI process (see `reduce_messages` method).
+ */
+void ParallelActorModel::start_reduction() {
+
+    reduction_contribution.clear();
+    for (auto &reduction: reductions) {
+        reduction_contribution.insert(reduction_contribution.end(), reduction.sum.begin(), reduction.sum.end());
+        std::fill(reduction.sum.begin(), reduction.sum.end(), 0);
+    }
+    for (int i = 0; i < counters_replica.size(); i++) {
+        reduction_contribution.push_back(counters_replica.local[i]);
+        counters_replica.pending[i] = counters_replica.local[i];
+        counters_replica.local[i] = 0;
+    }
+    if (termination_mode) {
+        reduction_contribution.push_back(termination.requested ? 1 : 0);
+        reduction_contribution.push_back(std::count_if(actors.begin(), actors.end(),
+                                                       [](const auto &kv) { return !kv.second->idle(); }));
+        reduction_contribution.push_back(counters.sent);
+        reduction_contribution.push_back(counters.received);
+    }
+    reduction_contribution.push_back(actors.empty() ? 0 : 1);
+    reduction_result.resize(reduction_contribution.size());
+
+    MPI_Iallreduce(reduction_contribution.data(), reduction_result.data(), static_cast<int>(reduction_result.size()),
+                   MPI_LONG, MPI_SUM, reduction_comm, &reduction_request);
+    last_reduction_time = MPI_Wtime();
+}
+
+/**
+ * Complete the reduction epochs started by any MPI process, starting the last of them on the MPI processes that
+ * have yet to, so that all MPI processes completed the same epochs. All MPI processes must call this method at
+ * the same point of the given communicator, e.g. within a load balancing epoch.
+ */
+void ParallelActorModel::align_reductions(MPI_Comm comm) {
+
+    long started = num_epochs + (reduction_request != MPI_REQUEST_NULL ? 1 : 0);
+    long target;
+    MPI_Allreduce(&started, &target, 1, MPI_LONG, MPI_MAX, comm);
+
+    while (reduction_mode && num_epochs < target) {
+        if (reduction_request == MPI_REQUEST_NULL) {
+            start_reduction();
+        }
+        MPI_Wait(&reduction_request, MPI_STATUS_IGNORE);
+        complete_reduction();
+    }
+}
+
+/**
+ * Write a checkpoint of all actors to the checkpoint file, from which a later run may resume, possibly on
+ * a different number of MPI processes (see `restore_checkpoint` method):
+ *
+ * (1) Deliver all messages in flight, i.e. until the number of messages sent and received by actors of all MPI
+ *     processes match, so that the state of the actors is all there is to save.
+ * (2) Each MPI process writes the state of its actors via their `checkpoint` method, along with its replica of
+ *     the counters and its share of the reduced messages, and all MPI processes write these records collectively
+ *     (see `write_records` method and `actor::CheckpointTrailer`).
+ * (3) Once all MPI processes wrote their records, the first MPI process appends the index of the records and
+ *     replaces the previous checkpoint, so that a run killed or failing while writing a checkpoint still resumes
+ *     from the previous one.
+ *
+ * All MPI processes call this method once they completed the same reduction epochs, and none is pending: between
+ * two reduction epochs, with collectives on the reduction communicator, or with migration, within a load balancing
+ * epoch, with collectives on the framework communicator (see `balance_load` method). If an actor does not support
+ * checkpoints, no checkpoint is written anymore.
+ */
+void ParallelActorModel::write_checkpoint(MPI_Comm comm) {
+
+    double start_time = MPI_Wtime();
+
+    // Deliver messages in flight
+    long in_flight;
+    do {
+        deliver_messages();
+        if (migration_mode) {
+            forward_messages();
+        }
+        long local = counters.sent - counters.received;
+        MPI_Allreduce(&local, &in_flight, 1, MPI_LONG, MPI_SUM, comm);
+    } while (in_flight != 0);
+
+    // Write the state of local actors
+    std::map<long, std::string> records;
+    int failed = 0;
+    for (const auto &kv: actors) {
+        std::vector<char> state;
+        auto serializer = actor::Serializer(state);
+        if (!kv.second->checkpoint(serializer)) {
+            failed = 1;
+        }
+        records[kv.first] = std::string(state.begin(), state.end());
+    }
+
+    // Write the state of current MPI process, with the increments of the counters yet to be merged and whether
+    // one of its actors requested the global stop, which may not have been detected yet
+    std::vector<char> state;
+    auto serializer = actor::Serializer(state);
+    std::vector<long> increments(counters_replica.size());
+    for (int i = 0; i < counters_replica.size(); i++) {
+        increments[i] = counters_replica.pending[i] + counters_replica.local[i];
+    }
+    serializer.write(counters_replica.merged);
+    serializer.write(increments);
+    for (const auto &reduction: reductions) {
+        serializer.write(reduction.sum);
+    }
+    serializer.write(termination.requested);
+    records[-1 - rank] = std::string(state.begin(), state.end());
+
+    int failed_anywhere;
+    MPI_Allreduce(&failed, &failed_anywhere, 1, MPI_INT, MPI_MAX, comm);
+    if (failed_anywhere) {
+        if (rank == 0) {
+            fprintf(stderr, "ERROR: checkpoints require all actors to support them\n");
+        }
+        checkpoint_filename.clear();
+        return;
+    }
+
+    long long wall_nanoseconds = monotonic_nanoseconds() - start_nanoseconds;
+    MPI_Allreduce(MPI_IN_PLACE, &wall_nanoseconds, 1, MPI_LONG_LONG, MPI_MAX, comm);
+
+    // Write records, then index and trailer
+    auto filename = checkpoint_filename + CHECKPOINT_SUFFIX;
+    std::vector<long> index;
+    int written = write_records(filename, records, comm, &index) ? 1 : 0;
+    int written_everywhere;
+    MPI_Allreduce(&written, &written_everywhere, 1, MPI_INT, MPI_MIN, comm);
+    bool success = written_everywhere == 1;
+
+    if (rank == 0 && success) {
+        auto trailer = actor::CheckpointTrailer{CHECKPOINT_MAGIC, num_procs, static_cast<long>(index.size() / 2),
+                                                wall_nanoseconds};
+        FILE *f = fopen(filename.c_str(), "ab");
+        success = f != nullptr;
+        if (success) {
+            success = fwrite(index.data(), sizeof(long), index.size(), f) == index.size()
+                      && fwrite(&trailer, sizeof(actor::CheckpointTrailer), 1, f) == 1;
+            success = fclose(f) == 0 && success;
+        }
+        success = success && std::rename(filename.c_str(), checkpoint_filename.c_str()) == 0;
+    }
+
+    if (rank == 0 && !success) {
+        fprintf(stderr, "ERROR: failed to write checkpoint %s\n", checkpoint_filename.c_str());
+    }
+
+    double end_time = MPI_Wtime();
+    if (log_debug && rank == 0) {
+        printf("[DEBUG] Framework write_checkpoint() takes %f seconds\n", end_time - start_time);
+        fflush(stdout);
+    }
+}
+
+/**
+ * Once the global stop reached current MPI process, call the `terminate` method of each local actor that has
+ * not been notified yet, including actors that migrated from an MPI process that had yet to detect it, and
+ * remove the actors that stop.
+ */
+void ParallelActorModel::terminate_actors() {
+
+    if (!termination.stopping) {
+        return;
+    }
+
+    std::vector<actor::id> stopped_actors;
+    for (const auto &kv: actors) {
+        if (termination.notified.insert(kv.first).second && kv.second->terminate() == actor::STOP) {
+            stopped_actors.push_back(kv.first);
+        }
+    }
+    finalize_actors(stopped_actors);
+}
+
+/**
+ * Run the execution cycle as a conservative discrete event simulation in logical time. Each actor reports
+ * the timestamp of its next event and its lookahead, and stamps the messages it sends. The execution cycle
+ * proceeds in windows:
+ *
+ * (1) Deliver all messages in flight, i.e. until the number of messages sent and received by actors of
+ *     all MPI processes match (see `drain_messages` method).
+ * (2) Compute the earliest next event T of all actors across all MPI processes. Since every message is sent
+ *     at least one lookahead L after the event that sends it, no actor can receive a message with a
+ *     timestamp below T + L during the window.
+ * (3) Each actor processes its events with timestamps below T + L via its `run` method.
+ *
+ * The execution cycle ends once all actors of all MPI processes stopped.
+ */
+void ParallelActorModel::run_windowed() {
+
+    // Width of a window
+    if (!compute_global_lookahead()) {
+        return;
+    }
+
+    int num_windows = 0;
+    double start_time = MPI_Wtime();
+    while (true) {
+
+        drain_messages();
+
+        // Earliest next event and whether any actor is left across all MPI processes
+        double local[2] = {NO_EVENT, actors.empty() ? 1.0 : 0.0};
+        for (const auto &kv: actors) {
+            local[0] = std::min(local[0], kv.second->next_event_time());
+        }
+
+        double global[2];
+        MPI_Allreduce(local, global, 2, MPI_DOUBLE, MPI_MIN, framework_comm);
+        if (global[1] == 1.0) {
+            break;
+        }
+
+        // Run actors up to the end of the window
+        std::vector<actor::id> stopped_actors;
+        for (const auto &kv: actors) {
+            auto &clock = kv.second->clock;
+            clock.safe_time = global[0] + global_lookahead;
+            if (run(kv.second) == actor::STOP) {
+                stopped_actors.push_back(kv.first);
+            }
+            clock.local_time = std::min(clock.safe_time, kv.second->next_event_time());
+        }
+        finalize_actors(stopped_actors);
+        snapshots.flush();
+        profile.count_cycle(counters);
+        num_windows++;
+    }
+
+    if (log_debug && rank == 0) {
+        printf("[DEBUG] Framework ran %d windows of %f lookahead in %f seconds\n",
+               num_windows, global_lookahead, MPI_Wtime() - start_time);
+        fflush(stdout);
+    }
+}
+
+/**
+ * Compute the minimum lookahead of all actors across all MPI processes.
+ * Returns false unless the lookahead is positive.
+ */
+bool ParallelActorModel::compute_global_lookahead() {
+
+    double local_lookahead = NO_EVENT;
+    for (const auto &kv: actors) {
+        local_lookahead = std::min(local_lookahead, kv.second->lookahead());
+    }
+
+    MPI_Allreduce(&local_lookahead, &global_lookahead, 1, MPI_DOUBLE, MPI_MIN, framework_comm);
+    if (global_lookahead <= 0) {
+        if (rank == 0) {
+            fprintf(stderr, "ERROR: logical time requires a positive lookahead\n");
+        }
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * Deliver messages until every message sent by an actor of any MPI process has been received.
+ * Actors receive all their messages via their `ingress` method. Messages addressed to stopped actors
+ * are discarded.
+ */
+void ParallelActorModel::drain_messages() {
+
+    long in_flight;
+    do {
+        deliver_messages();
+        long local = counters.sent - counters.received;
+        MPI_Allreduce(&local, &in_flight, 1, MPI_LONG, MPI_SUM, framework_comm);
+    } while (in_flight != 0);
+}
+
+/**
+ * Let every actor receive all the messages that arrived for it via its `ingress` method, and discard
+ * messages addressed to stopped actors.
+ */
+void ParallelActorModel::deliver_messages() {
+
+    std::vector<actor::id> stopped_actors;
+    for (const auto &kv: actors) {
+        if (receive_messages(kv.second, std::numeric_limits<int>::max()) == actor::STOP) {
+            stopped_actors.push_back(kv.first);
+        }
+    }
+    finalize_actors(stopped_actors);
+    discard_dead_letters();
+}
+
+/**
+ * Discard messages addressed to stopped actors.
+ */
+void ParallelActorModel::discard_dead_letters() {
+
+    auto context = mail::Context{&mail_types, &id_to_address, &counters, &reductions, &trace};
+    for (const auto &tag: stopped_tags) {
+        auto mailbox = mail::Mailbox(mail::Address(rank, tag), context);
+        while (mailbox.hasMessage()) {
+            mailbox.receive().discard();
+        }
+    }
+}
+
+/**
+ * Run the execution cycle as a conservative discrete event simulation in logical time, synchronized by
+ * null messages (Chandy-Misra-Bryant). Each actor declares the actors it sends timestamped messages to via its
+ * `channels` method, with a lookahead per channel. Every execution cycle:
+ *
+ * (1) Actors receive all their messages. A null message from another MPI process takes effect once all
+ *     messages sent before it have been received.
+ * (2) Each actor processes its events below its safe time, i.e. the earliest timestamp a message may still
+ *     have on any of its channels. A channel from a local actor is bounded by the sender's local time plus
+ *     the channel's lookahead, and a channel from another MPI process by the last null message from there.
+ * (3) Whenever the earliest timestamp current MPI process may still send to another MPI process increases,
+ *     it sends that time in a null message. Null messages are aggregated per pair of MPI processes.
+ *
+ * An MPI process leaves the execution cycle once all its actors stopped, without global synchronization.
+ */
+void ParallelActorModel::run_null_messages() {
+
+    if (!connect_channels()) {
+        if (rank == 0) {
+            fprintf(stderr, "ERROR: logical time requires a positive lookahead on every channel\n");
+        }
+        return;
+    }
+
+    int num_cycles = 0;
+    double start_time = MPI_Wtime();
+    while (!actors.empty()) {
+
+        deliver_messages();
+        receive_null_messages();
+
+        // Messages between local actors must all be received before computing safe times
+        if (counters.sent_to[rank] != counters.received_from[rank]) {
+            continue;
+        }
+
+        std::vector<double> safe_times;
+        for (const auto &kv: actors) {
+            double safe_time = NO_EVENT;
+            for (const auto &channel: local_channels[kv.first]) {
+                safe_time = std::min(safe_time, local_time(channel.first) + channel.second);
+            }
+            for (const auto &from_rank: remote_channels[kv.first]) {
+                safe_time = std::min(safe_time, channel_clock[from_rank]);
+            }
+            safe_times.push_back(safe_time);
+        }
+
+        std::vector<actor::id> stopped_actors;
+        int i = 0;
+        for (const auto &kv: actors) {
+            auto &clock = kv.second->clock;
+            clock.safe_time = safe_times[i++];
+            if (run(kv.second) == actor::STOP) {
+                stopped_actors.push_back(kv.first);
+            }
+            clock.local_time = std::min(clock.safe_time, kv.second->next_event_time());
+        }
+        finalize_actors(stopped_actors);
+        snapshots.flush();
+        profile.count_cycle(counters);
+
+        send_null_messages();
+        num_cycles++;
+    }
+
+    // Release MPI processes waiting on channels from current process
+    send_null_messages();
+
+    if (log_debug && rank == 0) {
+        printf("[DEBUG] Framework ran %d execution cycles with null messages in %f seconds\n",
+               num_cycles, MPI_Wtime() - start_time);
+        fflush(stdout);
+    }
+}
+
+/**
+ * Collect the channels declared by local actors and tell every MPI process which of its actors
+ * receive channels from current MPI process. Returns false unless all channels have a positive lookahead.
+ */
+bool ParallelActorModel::connect_channels() {
+
+    int valid = 1;
+    std::vector<std::vector<int>> destinations(num_procs);
+    for (const auto &kv: actors) {
+        for (const auto &to: kv.second->channels()) {
+
+            auto lookahead = kv.second->channel_lookahead(to);
+            if (lookahead <= 0) {
+                valid = 0;
+            }
+
+            auto to_rank = id_to_address.at(to).rank;
+            if (to_rank == rank) {
+                local_channels[to].emplace_back(kv.first, lookahead);
+            } else {
+                outgoing_channels[to_rank].emplace_back(kv.first, lookahead);
+                destinations[to_rank].push_back(to);
+            }
+        }
+    }
+
+    // Exchange the receivers of channels between MPI processes
+    std::vector<int> send_counts(num_procs), send_displacements(num_procs, 0), ids;
+    for (int r = 0; r < num_procs; r++) {
+        auto &ids_to_rank = destinations[r];
+        std::sort(ids_to_rank.begin(), ids_to_rank.end());
+        ids_to_rank.erase(std::unique(ids_to_rank.begin(), ids_to_rank.end()), ids_to_rank.end());
+        send_counts[r] = static_cast<int>(ids_to_rank.size());
+        send_displacements[r] = static_cast<int>(ids.size());
+        ids.insert(ids.end(), ids_to_rank.begin(), ids_to_rank.end());
+    }
+
+    std::vector<int> receive_counts(num_procs), receive_displacements(num_procs, 0);
+    MPI_Alltoall(send_counts.data(), 1, MPI_INT, receive_counts.data(), 1, MPI_INT, framework_comm);
+    for (int r = 1; r < num_procs; r++) {
+        receive_displacements[r] = receive_displacements[r - 1] + receive_counts[r - 1];
+    }
+
+    std::vector<int> receivers(receive_displacements.back() + receive_counts.back());
+    MPI_Alltoallv(ids.data(), send_counts.data(), send_displacements.data(), MPI_INT, receivers.data(),
+                  receive_counts.data(), receive_displacements.data(), MPI_INT, framework_comm);
+
+    for (int r = 0; r < num_procs; r++) {
+        for (int i = receive_displacements[r]; i < receive_displacements[r] + receive_counts[r]; i++) {
+            remote_channels[receivers[i]].push_back(r);
+        }
+    }
+
+    channel_clock.assign(num_procs, 0);
+    null_sent.assign(num_procs, 0);
+    null_received.assign(num_procs, {});
+
+    int all_valid;
+    MPI_Allreduce(&valid, &all_valid, 1, MPI_INT, MPI_MIN, framework_comm);
+    return all_valid == 1;
+}
+
+/**
+ * Returns the local time of a local actor, or NO_EVENT once the actor stopped.
+ */
+double ParallelActorModel::local_time(actor::id id) {
+    auto it = actors.find(id);
+    return it == actors.end() ? NO_EVENT : it->second->clock.local_time;
+}
+
+/**
+ * A null message promises that no message with a timestamp below `time` follows it. It takes effect once
+ * its receiver received the `num_messages` messages its sender sent to it beforehand.
+ */
+struct NullMessage {
+    double time;
+    long num_messages;
+};
+
+/**
+ * Receive pending null messages and advance the clock of each channel whose earlier messages all arrived.
+ */
+void ParallelActorModel::receive_null_messages() {
+
+    int flag;
+    MPI_Status status;
+    MPI_Iprobe(MPI_ANY_SOURCE, NULL_MESSAGE_TAG, framework_comm, &flag, &status);
+    while (flag) {
+        NullMessage null_message{};
+        MPI_Recv(&null_message, sizeof(NullMessage), MPI_BYTE, status.MPI_SOURCE, NULL_MESSAGE_TAG, framework_comm,
+                 MPI_STATUS_IGNORE);
+        null_received[status.MPI_SOURCE].emplace_back(null_message.num_messages, null_message.time);
+        MPI_Iprobe(MPI_ANY_SOURCE, NULL_MESSAGE_TAG, framework_comm, &flag, &status);
+    }
+
+    for (int r = 0; r < num_procs; r++) {
+        auto &pending = null_received[r];
+        while (!pending.empty() && pending.front().first <= counters.received_from[r]) {
+            channel_clock[r] = std::max(channel_clock[r], pending.front().second);
+            pending.pop_front();
+        }
+    }
+}
+
+/**
+ * Send a null message to each MPI process whose channels from current MPI process advanced.
+ */
+void ParallelActorModel::send_null_messages() {
+
+    for (const auto &kv: outgoing_channels) {
+
+        auto to_rank = kv.first;
+        double time = NO_EVENT;
+        for (const auto &channel: kv.second) {
+            time = std::min(time, local_time(channel.first) + channel.second);
+        }
+
+        if (time > null_sent[to_rank]) {
+            null_sent[to_rank] = time;
+            auto null_message = NullMessage{time, counters.sent_to[to_rank]};
+            MPI_Bsend(&null_message, sizeof(NullMessage), MPI_BYTE, to_rank, NULL_MESSAGE_TAG, framework_comm);
+        }
+    }
+}
+
+/**
+ * Let an actor receive and process up to the given number of messages via its `ingress` method,
+ * when the ingress mode is active. Returns whether the actor continues or stops.
+ */
+actor::next_step ParallelActorModel::receive_messages(actor::Actor *actor, int max_num_messages) {
+
+    auto next_step = actor::CONTINUE;
+    if (!ingress_mode) {
+        return next_step;
+    }
+
+    int messages = 0;
+    trace.current = actor->id;
+    while (next_step == actor::CONTINUE && messages < max_num_messages && actor->mailbox.hasMessage()) {
+        auto message = actor->mailbox.receive();
+        next_step = ingress(actor, message);
+        message.discard();
+        messages++;
+    }
+
+    // Keep track of batch sizes and of messages left waiting in the mailbox
+    if (profile.enabled) {
+        auto &actor_profile = profile.actors[actor->id];
+        actor_profile.max_batch = std::max(actor_profile.max_batch, messages);
+        if (next_step == actor::CONTINUE && messages == max_num_messages && actor->mailbox.hasMessage()) {
+            actor_profile.backlogged_cycles++;
+        }
+    }
+
+    return next_step;
+}
+
+/**
+ * Let an actor process a message via its `ingress` method, measuring the time spent when profiling is enabled
+ * and recording it when tracing is enabled.
+ */
+actor::next_step ParallelActorModel::ingress(actor::Actor *actor, mail::Message &message) {
+
+    if (!instrumented) {
+        return actor->ingress(message);
+    }
+
+    trace.current = actor->id;
+    trace.record(actor::TRACE_INGRESS_BEGIN, actor->id);
+    auto start = monotonic_nanoseconds();
+    auto next_step = actor->ingress(message);
+    auto nanoseconds = monotonic_nanoseconds() - start;
+    trace.record(actor::TRACE_INGRESS_END, actor->id);
+    if (profile.enabled) {
+        auto &actor_profile = profile.actors[actor->id];
+        actor_profile.ingress_calls++;
+        actor_profile.ingress_nanoseconds += nanoseconds;
+    }
+    return next_step;
+}
+
+/**
+ * Let an actor run via its `run` method, measuring the time spent when profiling is enabled and recording it
+ * when tracing is enabled.
+ */
+actor::next_step ParallelActorModel::run(actor::Actor *actor) {
+
+    if (!instrumented) {
+        return actor->run();
+    }
+
+    trace.current = actor->id;
+    trace.record(actor::TRACE_RUN_BEGIN, actor->id);
+    auto start = monotonic_nanoseconds();
+    auto next_step = actor->run();
+    auto nanoseconds = monotonic_nanoseconds() - start;
+    trace.record(actor::TRACE_RUN_END, actor->id);
+    if (profile.enabled) {
+        auto &actor_profile = profile.actors[actor->id];
+        actor_profile.run_calls++;
+        actor_profile.run_nanoseconds += nanoseconds;
+    }
+    return next_step;
+}
+
+/**
+ * Initialize the actors by executing the following steps in sequence:
+ *
+ * (1) For each actor, execute their `pre_barrier_init` methods.
+ * (2) Wait for all actors to complete the execution of their `pre_barrier_init`.
+ * (3) For each actor, execute their `post_barrier_init` methods.
+ */
+bool ParallelActorModel::initialize_actors() {
+
+    double start_time = MPI_Wtime();
+
+    // Run `pre_barrier_init` for each actor
+    for (const auto &kv: actors) {
+        auto success = kv.second->pre_barrier_init();
+        if (!success) {
+            return false;
+        }
+    }
+
+    // Wait for all actors to finish initialization
+    MPI_Barrier(MPI_COMM_WORLD);
+    start_nanoseconds = monotonic_nanoseconds();
+
+    // Run `post_barrier_init` for each actor
+    for (const auto &kv: actors) {
+        auto success = kv.second->post_barrier_init();
+        if (!success) {
+            return false;
+        }
+    }
+
+    double end_time = MPI_Wtime();
+    if (log_debug && rank == 0) {
+        printf("[DEBUG] Framework initialize_actors() takes %f seconds\n", end_time - start_time);
+        printf("[DEBUG] Framework directory takes %d bytes\n", id_to_address.memoryUsage());
+        fflush(stdout);
+    }
+
+    return true;
+}
+
+/**
+ * Restore the actors of current MPI process from the checkpoint file, in place of their initialization methods:
+ *
+ * (1) Every MPI process reads the index of the records (see `actor::CheckpointTrailer`).
+ * (2) All MPI processes read their records collectively, i.e. the records of their actors and the records of
+ *     the MPI processes that wrote the checkpoint. Actors resume via their `restore` method, and actors without
+ *     a record, i.e. that had stopped, are removed. Every MPI process restores its replica of the counters, and
+ *     the first MPI process takes over the increments and reduced messages that had yet to be merged.
+ * (3) Once all MPI processes restored their actors, the wall time of actors resumes from the checkpoint.
+ *     If any MPI process failed to read its records or restore its actors, all of them return false.
+ *
+ * The checkpoint may have been written by a different number of MPI processes.
+ */
+bool ParallelActorModel::restore_checkpoint() {
+
+    MPI_File file;
+    auto error = MPI_File_open(framework_comm, restore_filename.c_str(), MPI_MODE_RDONLY, MPI_INFO_NULL, &file);
+    if (error != MPI_SUCCESS) {
+        fprintf(stderr, "ERROR: failed to open %s\n", restore_filename.c_str());
+        return false;
+    }
+
+    // Read trailer and index
+    MPI_Offset file_size;
+    MPI_File_get_size(file, &file_size);
+    actor::CheckpointTrailer trailer{};
+    if (file_size >= sizeof(actor::CheckpointTrailer)) {
+        MPI_File_read_at(file, file_size - static_cast<MPI_Offset>(sizeof(actor::CheckpointTrailer)), &trailer,
+                         sizeof(actor::CheckpointTrailer), MPI_BYTE, MPI_STATUS_IGNORE);
+    }
+    auto index_offset = file_size - static_cast<MPI_Offset>(sizeof(actor::CheckpointTrailer))
+                        - 2 * trailer.num_records * static_cast<MPI_Offset>(sizeof(long));
+    if (trailer.magic != CHECKPOINT_MAGIC || trailer.num_records < 0 || index_offset < 0) {
+        fprintf(stderr, "ERROR: %s is not a checkpoint\n", restore_filename.c_str());
+        MPI_File_close(&file);
+        return false;
+    }
+
+    std::vector<long> index(2 * trailer.num_records);
+    MPI_File_read_at(file, index_offset, index.data(), static_cast<int>(index.size()), MPI_LONG, MPI_STATUS_IGNORE);
+
+    // Records to read, in increasing order of offset
+    std::vector<std::pair<long, int>> local;
+    std::vector<int> block_lengths;
+    std::vector<MPI_Aint> block_displacements;
+    long offset = 0;
+    long data_size = 0;
+    for (int i = 0; i < index.size(); i += 2) {
+        auto key = index[i];
+        auto size = static_cast<int>(index[i + 1]);
+        if ((key >= 0 && actors.count(static_cast<actor::id>(key)) > 0) || key == -1 || (key < 0 && rank == 0)) {
+            local.emplace_back(key, size);
+            block_lengths.push_back(size);
+            block_displacements.push_back(offset);
+            data_size += size;
+        }
+        offset += size;
+    }
+
+    MPI_Datatype file_type;
+    MPI_Type_create_hindexed(static_cast<int>(block_lengths.size()), block_lengths.data(),
+                             block_displacements.data(), MPI_BYTE, &file_type);
+    MPI_Type_commit(&file_type);
+
+    std::vector<char> data(data_size);
+    MPI_File_set_view(file, 0, MPI_BYTE, file_type, "native", MPI_INFO_NULL);
+    error = MPI_File_read_at_all(file, 0, data.data(), static_cast<int>(data.size()), MPI_BYTE, MPI_STATUS_IGNORE);
+    MPI_File_close(&file);
+    MPI_Type_free(&file_type);
+    auto success = error == MPI_SUCCESS;
+    if (!success) {
+        fprintf(stderr, "ERROR: failed to read %s\n", restore_filename.c_str());
+        local.clear();
+    }
+
+    // Restore actors and counters
+    std::vector<actor::id> stopped_actors;
+    for (const auto &kv: actors) {
+        stopped_actors.push_back(kv.first);
+    }
+
+    offset = 0;
+    for (const auto &record: local) {
+        auto deserializer = actor::Deserializer(data.data() + offset, record.second);
+        offset += record.second;
+
+        if (record.first >= 0) {
+            success = actors[static_cast<actor::id>(record.first)]->restore(deserializer) && success;
+            stopped_actors.erase(std::find(stopped_actors.begin(), stopped_actors.end(), record.first));
+            continue;
+        }
+
+        std::vector<long> merged;
+        std::vector<long> increments;
+        deserializer.read(merged);
+        deserializer.read(increments);
+        if (merged.size() != counters_replica.size() || increments.size() != counters_replica.size()) {
+            fprintf(stderr, "ERROR: checkpoint has %d counters rather than %d\n", static_cast<int>(merged.size()),
+                    counters_replica.size());
+            success = false;
+            break;
+        }
+        if (record.first == -1) {
+            counters_replica.merged = merged;
+        }
+        for (auto &reduction: reductions) {
+            std::vector<int> sum;
+            deserializer.read(sum);
+            for (int i = 0; rank == 0 && i < sum.size() && i < reduction.sum.size(); i++) {
+                reduction.sum[i] += sum[i];
+            }
+        }
+        for (int i = 0; rank == 0 && i < increments.size(); i++) {
+            counters_replica.local[i] += increments[i];
+        }
+        bool requested = false;
+        deserializer.read(requested);
+        termination.requested = termination.requested || (rank == 0 && requested);
+    }
+    if (success) {
+        finalize_actors(stopped_actors);
+    }
+
+    // Wait for all actors to be restored, and fail on all MPI processes if any of them failed
+    int all_success;
+    int local_success = success ? 1 : 0;
+    MPI_Allreduce(&local_success, &all_success, 1, MPI_INT, MPI_MIN, framework_comm);
+    if (all_success == 0) {
+        return false;
+    }
+
+    start_nanoseconds = monotonic_nanoseconds() - trailer.wall_nanoseconds;
+
+    if (log_debug && rank == 0) {
+        printf("[DEBUG] Framework resumes %ld records written by %d MPI processes after %f seconds\n",
+               trailer.num_records, trailer.num_procs,
+               static_cast<double>(trailer.wall_nanoseconds) / NANOSECONDS_PER_SECOND);
+        fflush(stdout);
+    }
+
+    return true;
+}
+
+/**
+ * Remove actors from the execution cycle that have terminated.
+ */
+void ParallelActorModel::finalize_actors(std::vector<actor::id> &stopped_actors) {
+    for (const auto &id: stopped_actors) {
+        auto actor = actors[id];
+        stopped_tags.push_back(actor->mailbox.address.tag);
+        actors.erase(id);
+        actor_load.erase(id);
+        outbox.sender = id;
+        actor->finalize();
+
+        auto history = histories.find(id);
+        if (history != histories.end()) {
+            for (auto &input: history->second.inputs) {
+                input.message.discard();
+            }
+            histories.erase(history);
+        }
+    }
+}
+
+/**
+ * Take part in load balancing when migration is enabled.
+ * Returns false once all actors of all MPI processes have stopped.
+ *
+ * A load balancing epoch starts once every MPI process has entered a non-blocking barrier. An MPI process enters
+ * the barrier `MIGRATION_INTERVAL` seconds after the previous epoch, or as soon as it has no actors left,
+ * and keeps running its actors until the barrier completes. The load of an MPI process is the average
+ * duration of its execution cycle, i.e. the sum of the average time spent in each of its actors per cycle.
+ *
+ * With checkpoints, a checkpoint due on any MPI process is written within the epoch, before actors migrate, once
+ * all MPI processes completed the same reduction epochs (see `align_reductions` and `write_checkpoint` methods).
+ */
+bool ParallelActorModel::balance_load() {
+
+    // Enter barrier of next epoch
+    if (epoch_request == MPI_REQUEST_NULL) {
+        if (!actors.empty() && MPI_Wtime() - last_epoch_time < MIGRATION_INTERVAL) {
+            return true;
+        }
+        MPI_Ibarrier(framework_comm, &epoch_request);
+    }
+
+    int flag = 0;
+    MPI_Test(&epoch_request, &flag, MPI_STATUS_IGNORE);
+    if (!flag) {
+        return true;
+    }
+
+    // Gather load and number of actors of all MPI processes, and whether a checkpoint is due on any of them
+    double local[3] = {0, static_cast<double>(actors.size()), checkpoint_due ? 1.0 : 0.0};
+    for (auto &kv: actor_load) {
+        kv.second /= std::max(1, num_sweeps);
+        local[0] += kv.second;
+    }
+
+    std::vector<double> global(3 * num_procs);
+    MPI_Allgather(local, 3, MPI_DOUBLE, global.data(), 3, MPI_DOUBLE, framework_comm);
+
+    double total_actors = 0;
+    bool checkpoint = false;
+    std::vector<double> load_by_rank(num_procs);
+    for (int r = 0; r < num_procs; r++) {
+        load_by_rank[r] = global[3 * r];
+        total_actors += global[3 * r + 1];
+        checkpoint = checkpoint || global[3 * r + 2] > 0;
+    }
+
+    if (total_actors == 0) {
+        return false;
+    }
+
+    // Write a checkpoint due on any MPI process before actors migrate
+    if (checkpoint) {
+        align_reductions(framework_comm);
+        if (!checkpoint_filename.empty() && !termination.stopping) {
+            write_checkpoint(framework_comm);
+        }
+        checkpoint_due = false;
+    }
+
+    recycle_tags();
+    migrate_actors(load_by_rank);
+
+    // Start measuring load of next epoch
+    for (auto &kv: actor_load) {
+        kv.second = 0;
+    }
+    num_sweeps = 0;
+    last_epoch_time = MPI_Wtime();
+
+    return true;
+}
+
+/**
+ * Stop forwarding messages of actors that migrated away in earlier epochs and reuse their tags, once every
+ * message sent to current MPI process has been received. All MPI processes know the new addresses of these
+ * actors since the epoch they migrated in, and no actor runs during an epoch, so no message can still be on
+ * its way to the old tags.
+ */
+void ParallelActorModel::recycle_tags() {
+
+    std::vector<long> sent_to_rank(num_procs);
+    MPI_Alltoall(counters.sent_to.data(), 1, MPI_LONG, sent_to_rank.data(), 1, MPI_LONG, framework_comm);
+    if (sent_to_rank != counters.received_from) {
+        return;
+    }
+
+    for (const auto &kv: forwarding) {
+        free_tags.push_back(kv.first);
+    }
+    forwarding.clear();
+}
+
+/**
+ * Move grouped actors from overloaded to underloaded MPI processes, given the load of every MPI process:
+ *
+ * (1) Every MPI process computes the same plan of load transfers between pairs of MPI processes managing
+ *     grouped actors. Only MPI processes exceeding the average load by `MIGRATION_THRESHOLD` give away load.
+ * (2) Each giving MPI process selects its most loaded actors that fit in the planned transfer, and sends
+ *     their serialized state to the receiving MPI process once the sizes of all transfers are exchanged.
+ *     The receiving MPI process creates them with a new tag, reusing the tags of actors that left if any.
+ * (3) The new addresses are shared with all MPI processes. Messages arriving at the old address of a
+ *     migrated actor are forwarded to its new address (see `forward_messages` method). An actor whose state
+ *     fails to deserialize on the receiving MPI process is deleted there and stays on the giving MPI process.
+ */
+void ParallelActorModel::migrate_actors(const std::vector<double> &load_by_rank) {
+
+    // Plan load transfers
+    auto num_grouped_procs = num_procs_for_grouped_actors;
+    double total_load = 0;
+    std::vector<double> excess(num_grouped_procs);
+    std::vector<int> order(num_grouped_procs);
+    for (int r = 0; r < num_grouped_procs; r++) {
+        total_load += load_by_rank[r];
+        order[r] = r;
+    }
+
+    auto average_load = total_load / num_grouped_procs;
+    for (int r = 0; r < num_grouped_procs; r++) {
+        excess[r] = load_by_rank[r] - average_load;
+        if (load_by_rank[r] <= MIGRATION_THRESHOLD * average_load) {
+            excess[r] = std::min(excess[r], 0.0);
+        }
+    }
+    std::sort(order.begin(), order.end(), [&excess](int a, int b) {
+        return excess[a] < excess[b] || (excess[a] == excess[b] && a < b);
+    });
+
+    struct Transfer {
+        int from;
+        int to;
+        double load;
+    };
+
+    std::vector<Transfer> transfers;
+    auto donor = num_grouped_procs - 1;
+    auto receiver = 0;
+    while (donor > receiver && excess[order[donor]] > 0 && excess[order[receiver]] < 0) {
+        auto load = std::min(excess[order[donor]], -excess[order[receiver]]);
+        transfers.push_back(Transfer{order[donor], order[receiver], load});
+        excess[order[donor]] -= load;
+        excess[order[receiver]] += load;
+        if (excess[order[donor]] <= 0) {
+            donor--;
+        }
+        if (excess[order[receiver]] >= 0) {
+            receiver++;
+        }
+    }
+
+    if (transfers.empty()) {
+        return;
+    }
+
+    // Select and send actors
+    std::vector<actor::id> departed_actors;
+    std::vector<std::vector<char>> send_buffers;
+    for (const auto &transfer: transfers) {
+
+        if (transfer.from != rank) {
+            continue;
+        }
+
+        std::vector<std::pair<double, actor::id>> candidates;
+        for (const auto &kv: actor_load) {
+            if (kv.second > 0 && kv.second <= transfer.load) {
+                candidates.emplace_back(kv.second, kv.first);
+            }
+        }
+        std::sort(candidates.rbegin(), candidates.rend());
+
+        std::vector<char> selected;
+        auto selected_serializer = actor::Serializer(selected);
+        int num_selected = 0;
+        auto remaining_load = transfer.load;
+        for (const auto &candidate: candidates) {
+
+            auto id = candidate.second;
+            if (candidate.first > remaining_load || std::find(departed_actors.begin(), departed_actors.end(), id)
+                                                    != departed_actors.end()) {
+                continue;
+            }
+
+            std::vector<char> state;
+            auto state_serializer = actor::Serializer(state);
+            if (!actors[id]->serialize(state_serializer)) {
+                continue;
+            }
+
+            selected_serializer.write(id);
+            selected_serializer.write(state);
+            departed_actors.push_back(id);
+            remaining_load -= candidate.first;
+            num_selected++;
+        }
+
+        std::vector<char> buffer;
+        actor::Serializer(buffer).write(num_selected);
+        buffer.insert(buffer.end(), selected.begin(), selected.end());
+        send_buffers.push_back(std::move(buffer));
+    }
+
+    // Exchange the sizes of transfers, then post all receives and sends at once
+    std::vector<int> send_sizes(num_procs, 0), receive_sizes(num_procs, 0);
+    int buffer_index = 0;
+    for (const auto &transfer: transfers) {
+        if (transfer.from == rank) {
+            send_sizes[transfer.to] = static_cast<int>(send_buffers[buffer_index++].size());
+        }
+    }
+    MPI_Alltoall(send_sizes.data(), 1, MPI_INT, receive_sizes.data(), 1, MPI_INT, framework_comm);
+
+    std::vector<MPI_Request> requests;
+    std::vector<std::vector<char>> receive_buffers;
+    for (const auto &transfer: transfers) {
+        if (transfer.to == rank) {
+            receive_buffers.emplace_back(receive_sizes[transfer.from]);
+            requests.emplace_back();
+            MPI_Irecv(receive_buffers.back().data(), receive_sizes[transfer.from], MPI_BYTE, transfer.from,
+                      MIGRATION_TAG, framework_comm, &requests.back());
+        }
+    }
+
+    buffer_index = 0;
+    for (const auto &transfer: transfers) {
+        if (transfer.from == rank) {
+            auto &buffer = send_buffers[buffer_index++];
+            requests.emplace_back();
+            MPI_Isend(buffer.data(), static_cast<int>(buffer.size()), MPI_BYTE, transfer.to, MIGRATION_TAG,
+                      framework_comm, &requests.back());
+        }
+    }
+
+    MPI_Waitall(static_cast<int>(requests.size()), requests.data(), MPI_STATUSES_IGNORE);
+
+    // Create received actors and assign them new addresses, or a negative rank when they stay where they were
+    std::vector<int> arrivals;
+    for (auto &buffer: receive_buffers) {
+
+        auto deserializer = actor::Deserializer(buffer.data(), static_cast<int>(buffer.size()));
+        int count;
+        deserializer.read(count);
+        for (int i = 0; i < count; i++) {
+
+            actor::id id;
+            std::vector<char> state;
+            deserializer.read(id);
+            deserializer.read(state);
+
+            auto actor = constructor(id);
+            auto state_deserializer = actor::Deserializer(state.data(), static_cast<int>(state.size()));
+            if (!actor->deserialize(state_deserializer)) {
+                fprintf(stderr, "ERROR: failed to deserialize actor %d, which stays on its MPI process\n", id);
+                actor->finalize();
+                arrivals.insert(arrivals.end(), {id, -1, 0});
+                continue;
+            }
+
+            auto tag = next_tag;
+            if (free_tags.empty()) {
+                next_tag++;
+            } else {
+                tag = free_tags.back();
+                free_tags.pop_back();
+            }
+
+            auto address = mail::Address(rank, tag);
+            store_actor(actor, address);
+            actor_load[id] = 0;
+            arrivals.insert(arrivals.end(), {id, address.rank, address.tag});
+        }
+    }
+
+    // Share new addresses with all MPI processes
+    auto num_arrivals = static_cast<int>(arrivals.size());
+    std::vector<int> counts(num_procs);
+    MPI_Allgather(&num_arrivals, 1, MPI_INT, counts.data(), 1, MPI_INT, framework_comm);
+
+    std::vector<int> displacements(num_procs, 0);
+    for (int r = 1; r < num_procs; r++) {
+        displacements[r] = displacements[r - 1] + counts[r - 1];
+    }
+
+    std::vector<int> addresses(displacements.back() + counts.back());
+    MPI_Allgatherv(arrivals.data(), num_arrivals, MPI_INT, addresses.data(), counts.data(), displacements.data(),
+                   MPI_INT, framework_comm);
+
+    int num_migrated = 0;
+    std::vector<actor::id> failed_actors;
+    for (int i = 0; i < addresses.size(); i += 3) {
+        if (addresses[i + 1] < 0) {
+            failed_actors.push_back(addresses[i]);
+            continue;
+        }
+        id_to_address.insert(addresses[i], mail::Address(addresses[i + 1], addresses[i + 2]));
+        num_migrated++;
+    }
+
+    // Remove departed actors and forward their messages from now on
+    for (const auto &id: departed_actors) {
+        if (std::find(failed_actors.begin(), failed_actors.end(), id) != failed_actors.end()) {
+            continue;
+        }
+        auto actor = actors[id];
+        forwarding[actor->mailbox.address.tag] = id;
+        actors.erase(id);
+        actor_load.erase(id);
+        actor->finalize();
+    }
+
+    if (log_debug && rank == 0) {
+        printf("[DEBUG] Framework migrated %d actors with maximum load %f and average load %f\n", num_migrated,
+               *std::max_element(load_by_rank.begin(), load_by_rank.begin() + num_grouped_procs), average_load);
+        fflush(stdout);
+    }
+}
+
+/**
+ * Forward messages that arrived at the old address of actors that migrated away from current MPI process.
+ */
+void ParallelActorModel::forward_messages() {
+
+    auto context = mail::Context{&mail_types, &id_to_address, &counters, &reductions, &trace};
+    for (const auto &kv: forwarding) {
+        auto mailbox = mail::Mailbox(mail::Address(rank, kv.first), context);
+        while (mailbox.hasMessage()) {
+            auto message = mailbox.receive();
+            mailbox.send(message, kv.second);
+            message.discard();
+        }
+    }
+}
+
+/**
+ * Run the execution cycle as an optimistic discrete event simulation in logical time (Time Warp):
+ *
+ * (1) Actors that support serialization process batches of events speculatively, each batch spanning one
+ *     lookahead from their earliest pending event, and no further than `OPTIMISTIC_WINDOW` lookaheads beyond
+ *     GVT. The framework saves their state before each batch and records the messages they send.
+ * (2) When a message arrives with a timestamp below the local time of its receiver (a straggler), the receiver
+ *     is rolled back to its latest checkpoint before that timestamp. The messages it sent since then are
+ *     cancelled with anti-messages, which annihilate them or roll back their receiver in turn.
+ * (3) Periodically, all MPI processes compute the global virtual time (GVT), i.e. the earliest timestamp that
+ *     may still be processed (see `advance_gvt` method). Older checkpoints and messages are discarded
+ *     (fossil collection), and actors that do not support serialization process the messages and events
+ *     that can no longer be rolled back, so that they may perform irreversible operations such as output.
+ *
+ * Reversible actors stop speculatively, and are finalized once GVT passes the time at which they stopped, while
+ * irreversible actors only stop on committed events. Messages arriving for a finalized actor are discarded.
+ * The execution cycle ends once all actors of all MPI processes stopped.
+ */
+void ParallelActorModel::run_optimistic() {
+
+    if (!compute_global_lookahead()) {
+        return;
+    }
+
+    for (const auto &kv: actors) {
+        std::vector<char> state;
+        auto serializer = actor::Serializer(state);
+        auto &history = histories[kv.first];
+        history.reversible = kv.second->serialize(serializer);
+        history.journal.sender = kv.first;
+        kv.second->mailbox.journal = &history.journal;
+        if (history.reversible && kv.second->output != nullptr) {
+            kv.second->output = &history.output;
+        }
+    }
+
+    int num_gvt = 0;
+    double start_time = MPI_Wtime();
+    last_epoch_time = start_time;
+    while (true) {
+
+        // Process batches of events speculatively
+        auto busy = false;
+        for (const auto &kv: actors) {
+
+            auto &history = histories[kv.first];
+            receive_inputs(kv.second, history);
+
+            if (history.reversible && history.stop_batch == 0) {
+                busy |= process_batch(kv.second, history, gvt + OPTIMISTIC_WINDOW * global_lookahead);
+            }
+        }
+        discard_dead_letters();
+        profile.count_cycle(counters);
+
+        // Enter barrier of next GVT computation
+        if (epoch_request == MPI_REQUEST_NULL) {
+            if (busy && MPI_Wtime() - last_epoch_time < GVT_INTERVAL) {
+                continue;
+            }
+            MPI_Ibarrier(framework_comm, &epoch_request);
+        }
+
+        int flag = 0;
+        MPI_Test(&epoch_request, &flag, MPI_STATUS_IGNORE);
+        if (!flag) {
+            continue;
+        }
+
+        num_gvt++;
+        if (!advance_gvt()) {
+            break;
+        }
+    }
+
+    if (log_debug && rank == 0) {
+        printf("[DEBUG] Framework computed GVT %d times with %ld rollbacks on rank 0 in %f seconds\n",
+               num_gvt, num_rollbacks, MPI_Wtime() - start_time);
+        fflush(stdout);
+    }
+}
+
+/**
+ * Receive the messages of an actor into its history. Anti-messages cancel the message they refer to,
+ * and stragglers roll back the actor before they are added. For an actor that stopped speculatively, a message
+ * up to the time at which it stopped is a straggler, since the actor might not have stopped had it arrived earlier.
+ */
+void ParallelActorModel::receive_inputs(actor::Actor *actor, actor::History &history) {
+
+    trace.current = actor->id;
+    while (actor->mailbox.hasMessage()) {
+
+        auto message = actor->mailbox.receive();
+        if (message.anti) {
+            cancel_input(actor, history, message);
+            message.discard();
+            continue;
+        }
+
+        auto straggler = history.stop_batch != 0 ? message.timestamp <= history.stop_time
+                                                 : message.timestamp < actor->clock.local_time;
+        if (history.reversible && straggler) {
+            auto index = static_cast<int>(history.checkpoints.size()) - 1;
+            while (history.checkpoints[index].time > message.timestamp) {
+                index--;
+            }
+            rollback(actor, history, index);
+        }
+
+        history.inputs.push_back(actor::Input{message, UNPROCESSED});
+    }
+}
+
+/**
+ * Annihilate the message cancelled by an anti-message, after rolling back the actor if it processed it.
+ */
+void ParallelActorModel::cancel_input(actor::Actor *actor, actor::History &history,
+                                      const mail::Message &anti_message) {
+
+    for (int i = 0; i < history.inputs.size(); i++) {
+
+        auto &input = history.inputs[i];
+        if (input.message.sender != anti_message.sender || input.message.sequence != anti_message.sequence) {
+            continue;
+        }
+
+        if (input.batch != UNPROCESSED) {
+            auto index = 0;
+            while (history.checkpoints[index].batch != input.batch) {
+                index++;
+            }
+            rollback(actor, history, index);
+        }
+
+        input.message.discard();
+        history.inputs.erase(history.inputs.begin() + i);
+        return;
+    }
+
+    fprintf(stderr, "ERROR: anti-message without message from actor %d\n", anti_message.sender);
+}
+
+/**
+ * Restore the state of an actor from the given checkpoint, along with the records it wrote, and resume it if it
+ * stopped speculatively. Messages processed since then are to be processed again, and messages sent since then
+ * are cancelled with anti-messages.
+ */
+void ParallelActorModel::rollback(actor::Actor *actor, actor::History &history, int checkpoint_index) {
+
+    auto &checkpoint = history.checkpoints[checkpoint_index];
+    auto deserializer = actor::Deserializer(checkpoint.state.data(), static_cast<int>(checkpoint.state.size()));
+    actor->deserialize(deserializer);
+    actor->clock.local_time = checkpoint.time;
+    history.output.records = checkpoint.records;
+    history.stop_batch = 0;
+
+    for (auto &input: history.inputs) {
+        if (input.batch >= checkpoint.batch) {
+            input.batch = UNPROCESSED;
+        }
+    }
+
+    auto &sent = history.journal.sent;
+    auto first_cancelled = std::find_if(sent.begin(), sent.end(), [&checkpoint](const mail::Sent &message) {
+        return message.batch >= checkpoint.batch;
+    });
+    for (auto it = first_cancelled; it != sent.end(); it++) {
+        actor->mailbox.cancel(*it);
+    }
+    sent.erase(first_cancelled, sent.end());
+
+    history.checkpoints.erase(history.checkpoints.begin() + checkpoint_index, history.checkpoints.end());
+    num_rollbacks++;
+}
+
+/**
+ * Let a reversible actor process a batch of events speculatively, from its earliest pending event up to one
+ * lookahead later, unless that event is beyond the given limit. Received messages are processed via `ingress`
+ * in timestamp order once the batch reaches their timestamp, followed by the `run` method. If the actor stops,
+ * the batch and the time at which it stopped are kept in its history (see `actor::History`).
+ * Returns true if a batch was processed.
+ */
+bool ParallelActorModel::process_batch(actor::Actor *actor, actor::History &history, double limit) {
+
+    double next_time = actor->next_event_time();
+    for (const auto &input: history.inputs) {
+        if (input.batch == UNPROCESSED) {
+            next_time = std::min(next_time, input.message.timestamp);
+        }
+    }
+
+    if (next_time >= limit) {
+        return false;
+    }
+
+    // Save state before the batch
+    auto batch = ++history.journal.batch;
+    history.checkpoints.push_back(actor::Checkpoint{actor->clock.local_time, batch, {}, history.output.records});
+    auto serializer = actor::Serializer(history.checkpoints.back().state);
+    actor->serialize(serializer);
+
+    // Process messages and events of the batch
+    auto end_time = next_time + global_lookahead;
+    std::vector<int> due;
+    for (int i = 0; i < history.inputs.size(); i++) {
+        if (history.inputs[i].batch == UNPROCESSED && history.inputs[i].message.timestamp < end_time) {
+            due.push_back(i);
+        }
+    }
+    std::sort(due.begin(), due.end(), [&history](int a, int b) {
+        auto &x = history.inputs[a].message;
+        auto &y = history.inputs[b].message;
+        return std::make_tuple(x.timestamp, x.sender, x.sequence) < std::make_tuple(y.timestamp, y.sender, y.sequence);
+    });
+
+    for (const auto &i: due) {
+        history.inputs[i].batch = batch;
+        if (ingress(actor, history.inputs[i].message) == actor::STOP) {
+            history.stop_batch = batch;
+            history.stop_time = history.inputs[i].message.timestamp;
+            return true;
+        }
+    }
+
+    actor->clock.safe_time = end_time;
+    if (run(actor) == actor::STOP) {
+        history.stop_batch = batch;
+        history.stop_time = end_time;
+    }
+    actor->clock.local_time = end_time;
+
+    return true;
+}
+
+/**
+ * Let an actor that does not support rollback process the messages and events that can no longer be rolled
+ * back, i.e. below GVT plus the lookahead, since any message still to be cancelled was sent at or after GVT.
+ */
+actor::next_step ParallelActorModel::process_committed(actor::Actor *actor, actor::History &history) {
+
+    auto end_time = gvt + global_lookahead;
+    std::vector<actor::Input> due;
+    std::vector<actor::Input> pending;
+    for (const auto &input: history.inputs) {
+        (input.message.timestamp < end_time ? due : pending).push_back(input);
+    }
+    history.inputs = pending;
+    std::sort(due.begin(), due.end(), [](const actor::Input &a, const actor::Input &b) {
+        auto &x = a.message;
+        auto &y = b.message;
+        return std::make_tuple(x.timestamp, x.sender, x.sequence) < std::make_tuple(y.timestamp, y.sender, y.sequence);
+    });
+
+    auto next_step = actor::CONTINUE;
+    for (auto &input: due) {
+        if (next_step == actor::CONTINUE) {
+            next_step = ingress(actor, input.message);
+        }
+        input.message.discard();
+    }
+
+    if (next_step == actor::CONTINUE) {
+        actor->clock.safe_time = end_time;
+        next_step = run(actor);
+        actor->clock.local_time = end_time;
+    }
+
+    return next_step;
+}
+
+/**
+ * Compute the global virtual time (GVT) once all MPI processes entered the barrier of a GVT computation.
+ * Returns false once all actors of all MPI processes have stopped.
+ *
+ * (1) Receive all messages in flight, i.e. until the number of messages sent and received by actors of all MPI
+ *     processes match. Anti-messages sent by the resulting rollbacks are received as well.
+ * (2) GVT is the earliest timestamp of any unprocessed message or event across all MPI processes, other than
+ *     those of actors that stopped speculatively, which only resume when rolled back by an earlier message.
+ * (3) Discard checkpoints, received messages and records of sent messages which can no longer be rolled back,
+ *     keeping the latest checkpoint at or before GVT.
+ * (4) Actors that stopped speculatively before GVT are finalized, and the records they wrote handed to the output
+ *     of the framework.
+ * (5) Actors that do not support rollback process committed messages and events (see `process_committed`).
+ */
+bool ParallelActorModel::advance_gvt() {
+
+    long in_flight;
+    do {
+        for (const auto &kv: actors) {
+            receive_inputs(kv.second, histories[kv.first]);
+        }
+        discard_dead_letters();
+        long local = counters.sent - counters.received;
+        MPI_Allreduce(&local, &in_flight, 1, MPI_LONG, MPI_SUM, framework_comm);
+    } while (in_flight != 0);
+
+    double local[2] = {NO_EVENT, actors.empty() ? 1.0 : 0.0};
+    for (const auto &kv: actors) {
+        if (histories[kv.first].stop_batch != 0) {
+            continue;
+        }
+        local[0] = std::min(local[0], kv.second->next_event_time());
+        for (const auto &input: histories[kv.first].inputs) {
+            if (input.batch == UNPROCESSED) {
+                local[0] = std::min(local[0], input.message.timestamp);
+            }
+        }
+    }
+
+    double global[2];
+    MPI_Allreduce(local, global, 2, MPI_DOUBLE, MPI_MIN, framework_comm);
+    if (global[1] == 1.0) {
+        return false;
+    }
+    gvt = global[0];
+
+    // Fossil collection
+    for (auto &kv: histories) {
+
+        auto &history = kv.second;
+        if (!history.reversible) {
+            history.journal.sent.clear();
+            continue;
+        }
+
+        auto &checkpoints = history.checkpoints;
+        auto index = static_cast<int>(checkpoints.size()) - 1;
+        while (index > 0 && checkpoints[index].time > gvt) {
+            index--;
+        }
+        if (index <= 0) {
+            continue;
+        }
+        checkpoints.erase(checkpoints.begin(), checkpoints.begin() + index);
+
+        auto committed_batch = checkpoints.front().batch;
+        std::vector<actor::Input> inputs;
+        for (auto &input: history.inputs) {
+            if (input.batch != UNPROCESSED && input.batch < committed_batch) {
+                input.message.discard();
+            } else {
+                inputs.push_back(input);
+            }
+        }
+        history.inputs = inputs;
+
+        auto &sent = history.journal.sent;
+        sent.erase(std::remove_if(sent.begin(), sent.end(), [committed_batch](const mail::Sent &message) {
+            return message.batch < committed_batch;
+        }), sent.end());
+    }
+
+    // Reversible actors that stopped before GVT
+    std::vector<actor::id> stopped_actors;
+    for (const auto &kv: actors) {
+        auto &history = histories[kv.first];
+        if (history.stop_batch != 0 && history.stop_time < gvt) {
+            for (const auto &record: history.output.records) {
+                output.write(record.first, record.second);
+            }
+            stopped_actors.push_back(kv.first);
+        }
+    }
+
+    // Irreversible actors
+    for (const auto &kv: actors) {
+        auto &history = histories[kv.first];
+        if (!history.reversible && process_committed(kv.second, history) == actor::STOP) {
+            stopped_actors.push_back(kv.first);
+        }
+    }
+    finalize_actors(stopped_actors);
+
+    last_epoch_time = MPI_Wtime();
+    return true;
+}
+
+/**
+ * Run the execution cycle in bulk synchronous ticks of logical time, each spanning the global lookahead:
+ *
+ * (1) All MPI processes agree on the next tick, i.e. the earliest tick holding any message or event.
+ * (2) Actors run in order of ID. Each receives its messages due in the tick via its `ingress` method,
+ *     in order of timestamp, sender and sequence, then calls its `run` method up to the end of the tick.
+ * (3) Messages sent during the tick are buffered and exchanged between all MPI processes in a single
+ *     all-to-all (see `exchange_messages` method). Since their timestamps are at least one lookahead later,
+ *     they are due in a later tick.
+ *
+ * Neither the wall clock nor the arrival order of messages affects the actors, so repeated runs on the same
+ * number of MPI processes produce identical results, and the duration of a tick is a stable performance metric.
+ * The execution cycle ends once all actors of all MPI processes stopped.
+ */
+void ParallelActorModel::run_bsp() {
+
+    // Length of a tick
+    if (!compute_global_lookahead()) {
+        return;
+    }
+
+    std::vector<actor::id> order;
+    for (const auto &kv: actors) {
+        order.push_back(kv.first);
+    }
+    std::sort(order.begin(), order.end());
+
+    int num_ticks = 0;
+    double exchange_seconds = 0;
+    double start_time = MPI_Wtime();
+    while (true) {
+
+        // Earliest message or event and whether any actor is left across all MPI processes
+        double local[2] = {NO_EVENT, actors.empty() ? 1.0 : 0.0};
+        for (const auto &kv: actors) {
+            local[0] = std::min(local[0], kv.second->next_event_time());
+            for (const auto &message: inboxes[kv.first]) {
+                local[0] = std::min(local[0], message.timestamp);
+            }
+        }
+
+        double global[2];
+        MPI_Allreduce(local, global, 2, MPI_DOUBLE, MPI_MIN, framework_comm);
+        if (global[1] == 1.0) {
+            break;
+        }
+
+        // Run actors up to the end of the tick
+        auto end_time = (std::floor(global[0] / global_lookahead) + 1) * global_lookahead;
+        std::vector<actor::id> stopped_actors;
+        for (const auto &id: order) {
+            auto actor = actors.find(id);
+            if (actor == actors.end()) {
+                continue;
+            }
+            outbox.sender = id;
+            if (run_tick(actor->second, inboxes[id], end_time) == actor::STOP) {
+                stopped_actors.push_back(id);
+            }
+        }
+        finalize_actors(stopped_actors);
+        snapshots.flush();
+        profile.count_cycle(counters);
+        for (const auto &id: stopped_actors) {
+            for (auto &message: inboxes[id]) {
+                message.discard();
+            }
+            inboxes.erase(id);
+        }
+
+        double exchange_start = MPI_Wtime();
+        exchange_messages();
+        exchange_seconds += MPI_Wtime() - exchange_start;
+        num_ticks++;
+    }
+
+    if (log_debug && rank == 0) {
+        auto seconds = MPI_Wtime() - start_time;
+        printf("[DEBUG] Framework ran %d ticks of %f lookahead in %f seconds (%f ms per tick, %f ms exchanging)\n",
+               num_ticks, global_lookahead, seconds, 1000 * seconds / std::max(1, num_ticks),
+               1000 * exchange_seconds / std::max(1, num_ticks));
+        fflush(stdout);
+    }
+}
+
+/**
+ * Let an actor receive its messages due before the end of the tick, in order of timestamp, sender and sequence,
+ * then run it up to the end of the tick.
+ */
+actor::next_step ParallelActorModel::run_tick(actor::Actor *actor, std::vector<mail::Message> &inbox,
+                                              double end_time) {
+
+    std::vector<mail::Message> due;
+    std::vector<mail::Message> pending;
+    for (const auto &message: inbox) {
+        (message.timestamp < end_time ? due : pending).push_back(message);
+    }
+    inbox = pending;
+    std::sort(due.begin(), due.end(), [](const mail::Message &x, const mail::Message &y) {
+        return std::make_tuple(x.timestamp, x.sender, x.sequence) < std::make_tuple(y.timestamp, y.sender, y.sequence);
+    });
+
+    auto next_step = actor::CONTINUE;
+    for (auto &message: due) {
+        if (next_step == actor::CONTINUE) {
+            next_step = ingress(actor, message);
+        }
+        message.discard();
+    }
+
+    if (next_step == actor::CONTINUE) {
+        actor->clock.safe_time = end_time;
+        next_step = run(actor);
+        actor->clock.local_time = end_time;
+    }
+
+    return next_step;
+}
+
+/**
+ * Exchange the messages buffered in the outbox between all MPI processes in a single all-to-all, and unpack
+ * them into the inboxes of their receivers. Messages addressed to stopped actors are discarded.
+ */
+void ParallelActorModel::exchange_messages() {
+
+    // Concatenate outgoing messages by rank
+    std::vector<int> send_counts(num_procs);
+    std::vector<int> send_displs(num_procs);
+    std::vector<char> send_buffer;
+    for (int r = 0; r < num_procs; r++) {
+        send_displs[r] = static_cast<int>(send_buffer.size());
+        send_counts[r] = static_cast<int>(outbox.buffers[r].size());
+        send_buffer.insert(send_buffer.end(), outbox.buffers[r].begin(), outbox.buffers[r].end());
+        outbox.buffers[r].clear();
+    }
+
+    std::vector<int> recv_counts(num_procs);
+    std::vector<int> recv_displs(num_procs);
+    MPI_Alltoall(send_counts.data(), 1, MPI_INT, recv_counts.data(), 1, MPI_INT, framework_comm);
+    int recv_size = 0;
+    for (int r = 0; r < num_procs; r++) {
+        recv_displs[r] = recv_size;
+        recv_size += recv_counts[r];
+    }
+
+    std::vector<char> recv_buffer(recv_size);
+    MPI_Alltoallv(send_buffer.data(), send_counts.data(), send_displs.data(), MPI_BYTE,
+                  recv_buffer.data(), recv_counts.data(), recv_displs.data(), MPI_BYTE, framework_comm);
+
+    // Receiving actor of each tag
+    std::unordered_map<int, actor::id> tag_to_id;
+    for (const auto &kv: actors) {
+        tag_to_id[kv.second->mailbox.address.tag] = kv.first;
+    }
+
+    // Unpack incoming messages
+    for (int r = 0; r < num_procs; r++) {
+        auto offset = recv_displs[r];
+        while (offset < recv_displs[r] + recv_counts[r]) {
+
+            mail::Header header{};
+            int tag;
+            int size;
+            std::memcpy(&header, recv_buffer.data() + offset, sizeof(mail::Header));
+            std::memcpy(&tag, recv_buffer.data() + offset + sizeof(mail::Header), sizeof(int));
+            std::memcpy(&size, recv_buffer.data() + offset + sizeof(mail::Header) + sizeof(int), sizeof(int));
+            auto payload = recv_buffer.data() + offset + sizeof(mail::Header) + 2 * sizeof(int);
+            offset += static_cast<int>(sizeof(mail::Header) + 2 * sizeof(int)) + size;
+            counters.received++;
+            counters.received_from[r]++;
+            auto &received_type = mail_types[header.type_index];
+            counters.received_by_type[header.type_index]++;
+            counters.bytes_received_by_type[header.type_index] +=
+                    received_type.decode != nullptr ? size : static_cast<long>(received_type.size_bytes) * header.count;
+
+            auto receiver = tag_to_id.find(tag);
+            if (receiver == tag_to_id.end()) {
+                continue;
+            }
+            if (trace.enabled) {
+                trace.record(actor::TRACE_RECEIVE, receiver->second,
+                             actor::Trace::flow_id(header.sender, header.sequence, r));
+            }
+
+            auto &type = mail_types[header.type_index];
+            mail::Message message;
+            message.count = header.count;
+            message.data = malloc(type.size_bytes * header.count);
+            message.mpi_datatype = type.mpi_datatype;
+            message.timestamp = header.timestamp;
+            message.sender = header.sender;
+            message.sequence = header.sequence;
+
+            if (type.decode != nullptr) {
+                type.decode(payload, size, message.data, header.count);
+            } else {
+                int position = 0;
+                MPI_Unpack(payload, size, &position, message.data, header.count, type.mpi_datatype, MPI_COMM_WORLD);
+            }
+            inboxes[receiver->second].push_back(message);
+        }
     }
 }
@@ -0,0 +1,8 @@
+#include "actor/output.h"
+
+/**
+ * Write a record under the given key, replacing any record previously written under this key.
+ */
+void actor::Output::write(long key, const std::string &record) {
+    records[key] = record;
+}
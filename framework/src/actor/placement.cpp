@@ -0,0 +1,544 @@
+#include <algorithm>
+#include <cmath>
+#include <set>
+#include <tuple>
+#include <utility>
+#include "actor/placement.h"
+
+placement::Graph::Graph() = default;
+
+/**
+ * Build a communication graph from (possibly directed) adjacency lists, where adjacency[i] lists the
+ * actors that actor i sends messages to. Edges are made undirected, self loops are dropped and parallel
+ * edges are merged into a single edge whose weight is the number of merged edges. Each vertex has unit weight.
+ */
+placement::Graph::Graph(const std::vector<std::vector<int>> &adjacency) {
+
+    auto num_vertices = static_cast<int>(adjacency.size());
+
+    // Symmetrise adjacency lists
+    std::vector<std::vector<std::pair<int, int>>> neighbours(num_vertices);
+    for (int u = 0; u < num_vertices; u++) {
+        for (const auto &v: adjacency[u]) {
+            if (u != v && v >= 0 && v < num_vertices) {
+                neighbours[u].emplace_back(v, 1);
+                neighbours[v].emplace_back(u, 1);
+            }
+        }
+    }
+
+    // Merge parallel edges and store in CSR format
+    xadj.push_back(0);
+    for (int u = 0; u < num_vertices; u++) {
+        std::sort(neighbours[u].begin(), neighbours[u].end());
+        for (const auto &edge: neighbours[u]) {
+            if (adjncy.size() > xadj.back() && adjncy.back() == edge.first) {
+                adjwgt.back() += edge.second;
+            } else {
+                adjncy.push_back(edge.first);
+                adjwgt.push_back(edge.second);
+            }
+        }
+        xadj.push_back(static_cast<int>(adjncy.size()));
+        neighbours[u].clear();
+        neighbours[u].shrink_to_fit();
+    }
+
+    vwgt = std::vector<int>(num_vertices, 1);
+}
+
+/**
+ * Returns the number of vertices in the graph.
+ */
+int placement::Graph::size() const {
+    return static_cast<int>(vwgt.size());
+}
+
+/**
+ * Returns the sum of the vertex weights of the graph.
+ */
+static long total_vertex_weight(const placement::Graph &graph) {
+    long total = 0;
+    for (const auto &weight: graph.vwgt) {
+        total += weight;
+    }
+    return total;
+}
+
+/**
+ * Contract a graph using heavy edge matching.
+ * Each vertex is matched with the unmatched neighbour it shares the heaviest edge with, and each matched pair
+ * becomes a single vertex of the coarse graph. On return, `coarse_map[v]` is the coarse vertex of vertex v.
+ */
+static placement::Graph coarsen(const placement::Graph &graph, std::vector<int> &coarse_map) {
+
+    auto num_vertices = graph.size();
+    auto max_vertex_weight = std::max(1L, 3 * total_vertex_weight(graph) / (2 * COARSEST_GRAPH_SIZE));
+
+    // Visit vertices of low degree first so that they are not left unmatched
+    std::vector<int> order(num_vertices);
+    for (int v = 0; v < num_vertices; v++) {
+        order[v] = v;
+    }
+    std::stable_sort(order.begin(), order.end(), [&graph](int u, int v) {
+        return graph.xadj[u + 1] - graph.xadj[u] < graph.xadj[v + 1] - graph.xadj[v];
+    });
+
+    // Match vertices
+    std::vector<int> match(num_vertices, -1);
+    std::vector<int> representative;
+    coarse_map.assign(num_vertices, -1);
+    for (const auto &v: order) {
+
+        if (coarse_map[v] != -1) {
+            continue;
+        }
+
+        int best = v;
+        int best_weight = -1;
+        for (int e = graph.xadj[v]; e < graph.xadj[v + 1]; e++) {
+            auto u = graph.adjncy[e];
+            if (coarse_map[u] == -1 && graph.adjwgt[e] > best_weight
+                && graph.vwgt[u] + graph.vwgt[v] <= max_vertex_weight) {
+                best = u;
+                best_weight = graph.adjwgt[e];
+            }
+        }
+
+        match[v] = best;
+        match[best] = v;
+        coarse_map[v] = static_cast<int>(representative.size());
+        coarse_map[best] = static_cast<int>(representative.size());
+        representative.push_back(v);
+    }
+
+    // Build coarse graph, merging the edges of matched vertices
+    auto num_coarse_vertices = static_cast<int>(representative.size());
+    placement::Graph coarse;
+    coarse.vwgt.assign(num_coarse_vertices, 0);
+    coarse.xadj.push_back(0);
+    std::vector<int> position(num_coarse_vertices, -1);
+    for (int c = 0; c < num_coarse_vertices; c++) {
+
+        auto start = static_cast<int>(coarse.adjncy.size());
+        auto v = representative[c];
+        int members[2] = {v, match[v]};
+        auto num_members = match[v] == v ? 1 : 2;
+
+        for (int i = 0; i < num_members; i++) {
+            auto member = members[i];
+            coarse.vwgt[c] += graph.vwgt[member];
+            for (int e = graph.xadj[member]; e < graph.xadj[member + 1]; e++) {
+                auto u = coarse_map[graph.adjncy[e]];
+                if (u == c) {
+                    continue;
+                }
+                if (position[u] >= start) {
+                    coarse.adjwgt[position[u]] += graph.adjwgt[e];
+                } else {
+                    position[u] = static_cast<int>(coarse.adjncy.size());
+                    coarse.adjncy.push_back(u);
+                    coarse.adjwgt.push_back(graph.adjwgt[e]);
+                }
+            }
+        }
+
+        coarse.xadj.push_back(static_cast<int>(coarse.adjncy.size()));
+    }
+
+    return coarse;
+}
+
+/**
+ * Returns the total weight of edges whose endpoints lie on different sides of a bisection.
+ */
+static long bisection_cut(const placement::Graph &graph, const std::vector<int> &side) {
+    long cut = 0;
+    for (int v = 0; v < graph.size(); v++) {
+        for (int e = graph.xadj[v]; e < graph.xadj[v + 1]; e++) {
+            if (side[v] != side[graph.adjncy[e]]) {
+                cut += graph.adjwgt[e];
+            }
+        }
+    }
+    return cut / 2;
+}
+
+/**
+ * Bisect a graph by greedy graph growing.
+ * Starting from `seed`, side 0 grows one vertex at a time, always absorbing the vertex that decreases
+ * the edge cut the most, until it reaches the target weight. All other vertices are assigned to side 1.
+ * Frontier vertices are kept ordered by gain, so that each step takes logarithmic rather than linear time.
+ */
+static void grow_bisection(const placement::Graph &graph, int seed, double target_weight, std::vector<int> &side) {
+
+    auto num_vertices = graph.size();
+    side.assign(num_vertices, 1);
+
+    // gain[v] is the reduction in edge cut when moving v from side 1 to side 0
+    std::vector<long> gain(num_vertices, 0);
+    for (int v = 0; v < num_vertices; v++) {
+        for (int e = graph.xadj[v]; e < graph.xadj[v + 1]; e++) {
+            gain[v] -= graph.adjwgt[e];
+        }
+    }
+
+    // Frontier vertices of side 1 by decreasing gain, then increasing index
+    std::set<std::pair<long, int>> frontier;
+    std::vector<bool> in_frontier(num_vertices, false);
+    int first_unassigned = 0;
+
+    long weight = 0;
+    auto next = seed;
+    while (next != -1) {
+
+        if (weight > 0 && weight + graph.vwgt[next] - target_weight > target_weight - weight) {
+            break;
+        }
+
+        // Move vertex to side 0 and update gains of its neighbours
+        side[next] = 0;
+        weight += graph.vwgt[next];
+        if (in_frontier[next]) {
+            frontier.erase({-gain[next], next});
+            in_frontier[next] = false;
+        }
+        for (int e = graph.xadj[next]; e < graph.xadj[next + 1]; e++) {
+            auto u = graph.adjncy[e];
+            if (side[u] == 0) {
+                continue;
+            }
+            if (in_frontier[u]) {
+                frontier.erase({-gain[u], u});
+            }
+            gain[u] += 2 * graph.adjwgt[e];
+            frontier.insert({-gain[u], u});
+            in_frontier[u] = true;
+        }
+
+        if (weight >= target_weight) {
+            break;
+        }
+
+        // Select the frontier vertex with highest gain, or any vertex if side 0 is a complete component
+        next = -1;
+        if (!frontier.empty()) {
+            next = frontier.begin()->second;
+            continue;
+        }
+        while (first_unassigned < num_vertices && side[first_unassigned] == 0) {
+            first_unassigned++;
+        }
+        if (first_unassigned < num_vertices) {
+            next = first_unassigned;
+        }
+    }
+}
+
+/**
+ * Improve a bisection by moving boundary vertices between the two sides.
+ * Vertices on an overweight side are moved first to restore balance. Afterwards, a vertex is moved if it
+ * reduces the edge cut, or if it keeps the edge cut and reduces the imbalance, without overloading the other side.
+ * Gains are updated incrementally as vertices move, and the candidates for restoring balance are kept ordered,
+ * so that each move takes time proportional to the degree of the moved vertex rather than to the graph size.
+ */
+static void refine_bisection(const placement::Graph &graph, const long max_weight[2], std::vector<int> &side) {
+
+    auto num_vertices = graph.size();
+    long weight[2] = {0, 0};
+    for (int v = 0; v < num_vertices; v++) {
+        weight[side[v]] += graph.vwgt[v];
+    }
+
+    // gain[v] is the reduction in edge cut when moving v to the other side, and v is a boundary vertex
+    // if external[v], the weight of its edges to the other side, is positive
+    std::vector<long> gain(num_vertices, 0);
+    std::vector<long> external(num_vertices, 0);
+    std::vector<long> total(num_vertices, 0);
+    for (int v = 0; v < num_vertices; v++) {
+        for (int e = graph.xadj[v]; e < graph.xadj[v + 1]; e++) {
+            total[v] += graph.adjwgt[e];
+            if (side[graph.adjncy[e]] != side[v]) {
+                external[v] += graph.adjwgt[e];
+            }
+        }
+        gain[v] = 2 * external[v] - total[v];
+    }
+
+    // Move a vertex to the other side, updating the gains of its neighbours
+    auto move = [&graph, &side, &weight, &gain, &external, &total](int v) {
+        auto from = side[v];
+        auto to = 1 - from;
+        side[v] = to;
+        weight[from] -= graph.vwgt[v];
+        weight[to] += graph.vwgt[v];
+        external[v] = total[v] - external[v];
+        gain[v] = -gain[v];
+        for (int e = graph.xadj[v]; e < graph.xadj[v + 1]; e++) {
+            auto u = graph.adjncy[e];
+            auto sign = side[u] == to ? -1 : 1;
+            external[u] += sign * graph.adjwgt[e];
+            gain[u] += 2 * sign * graph.adjwgt[e];
+        }
+    };
+
+    // Restore balance, preferring boundary vertices, then higher gain, then lower index
+    auto key = [&gain, &external](int v) {
+        return std::make_tuple(external[v] == 0, -gain[v], v);
+    };
+    for (int s = 0; s < 2; s++) {
+
+        if (weight[s] <= max_weight[s]) {
+            continue;
+        }
+
+        std::set<std::tuple<bool, long, int>> candidates;
+        for (int v = 0; v < num_vertices; v++) {
+            if (side[v] == s) {
+                candidates.insert(key(v));
+            }
+        }
+
+        while (weight[s] > max_weight[s]) {
+            int best = -1;
+            for (const auto &candidate: candidates) {
+                auto v = std::get<2>(candidate);
+                if (weight[1 - s] + graph.vwgt[v] <= max_weight[1 - s]) {
+                    best = v;
+                    break;
+                }
+            }
+            if (best == -1) {
+                break;
+            }
+
+            candidates.erase(key(best));
+            for (int e = graph.xadj[best]; e < graph.xadj[best + 1]; e++) {
+                candidates.erase(key(graph.adjncy[e]));
+            }
+            move(best);
+            for (int e = graph.xadj[best]; e < graph.xadj[best + 1]; e++) {
+                auto u = graph.adjncy[e];
+                if (side[u] == s) {
+                    candidates.insert(key(u));
+                }
+            }
+        }
+    }
+
+    // Reduce edge cut
+    for (int pass = 0; pass < REFINEMENT_PASSES; pass++) {
+
+        int moved = 0;
+        for (int v = 0; v < num_vertices; v++) {
+
+            auto from = side[v];
+            auto to = 1 - from;
+            if (external[v] == 0 || weight[to] + graph.vwgt[v] > max_weight[to]) {
+                continue;
+            }
+
+            auto improves_balance = weight[from] - graph.vwgt[v] > weight[to];
+            if (gain[v] > 0 || (gain[v] == 0 && improves_balance)) {
+                move(v);
+                moved++;
+            }
+        }
+
+        if (moved == 0) {
+            break;
+        }
+    }
+}
+
+/**
+ * Bisect a graph with the multilevel scheme, such that side 0 receives `fraction` of the total vertex weight
+ * and neither side exceeds its target weight by more than a factor of `imbalance`:
+ *
+ * (1) Coarsen the graph by repeated heavy edge matching.
+ * (2) Bisect the coarsest graph by greedy graph growing.
+ * (3) Project the bisection back to the original graph, refining it at each level.
+ */
+static void bisect(const placement::Graph &graph, double fraction, double imbalance, std::vector<int> &side) {
+
+    // Coarsening phase
+    std::vector<placement::Graph> coarse_graphs;
+    std::vector<std::vector<int>> coarse_maps;
+    auto level = [&graph, &coarse_graphs](int i) -> const placement::Graph & {
+        return i == 0 ? graph : coarse_graphs[i - 1];
+    };
+
+    int num_levels = 1;
+    while (level(num_levels - 1).size() > COARSEST_GRAPH_SIZE) {
+        std::vector<int> coarse_map;
+        auto coarse = coarsen(level(num_levels - 1), coarse_map);
+        if (coarse.size() > MIN_COARSENING_RATIO * level(num_levels - 1).size()) {
+            break;
+        }
+        coarse_graphs.push_back(std::move(coarse));
+        coarse_maps.push_back(std::move(coarse_map));
+        num_levels++;
+    }
+
+    auto total_weight = total_vertex_weight(graph);
+    double target_weight[2] = {fraction * total_weight, (1 - fraction) * total_weight};
+    long max_weight[2];
+    for (int s = 0; s < 2; s++) {
+        max_weight[s] = static_cast<long>(std::max(std::ceil(target_weight[s]), target_weight[s] * imbalance));
+    }
+
+    // Initial partitioning phase: keep the best of several deterministic seeds
+    const auto &coarsest = level(num_levels - 1);
+    long best_cut = -1;
+    for (int trial = 0; trial < 4 && trial < coarsest.size(); trial++) {
+        std::vector<int> candidate;
+        grow_bisection(coarsest, trial * coarsest.size() / 4, target_weight[0], candidate);
+        refine_bisection(coarsest, max_weight, candidate);
+        auto cut = bisection_cut(coarsest, candidate);
+        if (best_cut == -1 || cut < best_cut) {
+            best_cut = cut;
+            side = candidate;
+        }
+    }
+
+    // Uncoarsening phase
+    for (int i = num_levels - 2; i >= 0; i--) {
+        const auto &fine = level(i);
+        std::vector<int> projected(fine.size());
+        for (int v = 0; v < fine.size(); v++) {
+            projected[v] = side[coarse_maps[i][v]];
+        }
+        side = std::move(projected);
+        refine_bisection(fine, max_weight, side);
+    }
+}
+
+/**
+ * Returns the subgraph induced by the given vertices. Vertex i of the subgraph is vertices[i] of the graph.
+ */
+static placement::Graph induced_subgraph(const placement::Graph &graph, const std::vector<int> &vertices) {
+
+    std::vector<int> local(graph.size(), -1);
+    for (int i = 0; i < vertices.size(); i++) {
+        local[vertices[i]] = i;
+    }
+
+    placement::Graph subgraph;
+    subgraph.xadj.push_back(0);
+    for (const auto &v: vertices) {
+        for (int e = graph.xadj[v]; e < graph.xadj[v + 1]; e++) {
+            auto u = local[graph.adjncy[e]];
+            if (u != -1) {
+                subgraph.adjncy.push_back(u);
+                subgraph.adjwgt.push_back(graph.adjwgt[e]);
+            }
+        }
+        subgraph.xadj.push_back(static_cast<int>(subgraph.adjncy.size()));
+        subgraph.vwgt.push_back(graph.vwgt[v]);
+    }
+
+    return subgraph;
+}
+
+/**
+ * Assign parts `first_part` to `first_part + num_parts - 1` to the given vertices of the original graph
+ * by recursively bisecting their induced subgraph `graph`.
+ */
+static void recursive_bisection(const placement::Graph &graph, const std::vector<int> &vertices,
+                                int num_parts, int first_part, std::vector<int> &parts) {
+
+    if (num_parts == 1 || graph.size() <= 1) {
+        for (const auto &v: vertices) {
+            parts[v] = first_part;
+        }
+        return;
+    }
+
+    // Spread the allowed imbalance over the remaining levels of recursion, since imbalances compound
+    auto remaining_levels = std::ceil(std::log2(num_parts));
+    auto imbalance = 1 + (MAX_IMBALANCE - 1) / remaining_levels;
+
+    auto left_parts = num_parts / 2;
+    std::vector<int> side;
+    bisect(graph, static_cast<double>(left_parts) / num_parts, imbalance, side);
+
+    std::vector<int> local_vertices[2];
+    for (int v = 0; v < graph.size(); v++) {
+        local_vertices[side[v]].push_back(v);
+    }
+
+    for (int s = 0; s < 2; s++) {
+        std::vector<int> global_vertices;
+        for (const auto &v: local_vertices[s]) {
+            global_vertices.push_back(vertices[v]);
+        }
+        auto subgraph = induced_subgraph(graph, local_vertices[s]);
+        auto sub_parts = s == 0 ? left_parts : num_parts - left_parts;
+        auto sub_first_part = s == 0 ? first_part : first_part + left_parts;
+        recursive_bisection(subgraph, global_vertices, sub_parts, sub_first_part, parts);
+    }
+}
+
+/**
+ * Partition a graph into `num_parts` parts of balanced vertex weight while minimizing the edge cut.
+ * Returns the part of each vertex.
+ *
+ * The graph is partitioned by multilevel recursive bisection. As a consequence, parts with neighbouring
+ * indices hold neighbouring regions of the graph. The result is deterministic, so every MPI process computes
+ * the same partition without communication.
+ */
+std::vector<int> placement::partition(const Graph &graph, int num_parts) {
+
+    std::vector<int> parts(graph.size(), 0);
+    std::vector<int> vertices(graph.size());
+    for (int v = 0; v < graph.size(); v++) {
+        vertices[v] = v;
+    }
+
+    recursive_bisection(graph, vertices, num_parts, 0, parts);
+    return parts;
+}
+
+/**
+ * Split vertices into `num_parts` contiguous blocks of balanced weight, where weights[i] is the weight of vertex i.
+ * Returns the part of each vertex.
+ *
+ * Vertex i is assigned to the part containing the midpoint of its weight in the prefix sum of all weights.
+ */
+std::vector<int> placement::blocks(const std::vector<int> &weights, int num_parts) {
+
+    long total_weight = 0;
+    for (const auto &weight: weights) {
+        total_weight += weight;
+    }
+
+    std::vector<int> parts(weights.size(), 0);
+    if (total_weight == 0) {
+        return parts;
+    }
+
+    long prefix_weight = 0;
+    for (int v = 0; v < weights.size(); v++) {
+        auto midpoint = static_cast<double>(prefix_weight) + weights[v] / 2.0;
+        auto part = static_cast<int>(midpoint * num_parts / total_weight);
+        parts[v] = std::min(part, num_parts - 1);
+        prefix_weight += weights[v];
+    }
+
+    return parts;
+}
+
+/**
+ * Returns the total weight of edges whose endpoints are assigned to different parts.
+ */
+int placement::edge_cut(const Graph &graph, const std::vector<int> &parts) {
+    long cut = 0;
+    for (int v = 0; v < graph.size(); v++) {
+        for (int e = graph.xadj[v]; e < graph.xadj[v + 1]; e++) {
+            if (parts[v] != parts[graph.adjncy[e]]) {
+                cut += graph.adjwgt[e];
+            }
+        }
+    }
+    return static_cast<int>(cut / 2);
+}
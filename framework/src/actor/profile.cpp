@@ -0,0 +1,67 @@
+#include <algorithm>
+#include <cstdio>
+#include "actor/profile.h"
+#include "actor/clock.h"
+
+/**
+ * Count an execution cycle, along with the bytes sent with MPI_Bsend during the cycle.
+ */
+void actor::Profile::count_cycle(const mail::Counters &counters) {
+    cycles++;
+    max_cycle_bytes = std::max(max_cycle_bytes, counters.bytes_sent - last_bytes_sent);
+    last_bytes_sent = counters.bytes_sent;
+}
+
+/**
+ * Returns the duration of the execution cycle in seconds.
+ */
+double actor::Profile::seconds() const {
+    return static_cast<double>(end_nanoseconds - start_nanoseconds) / NANOSECONDS_PER_SECOND;
+}
+
+/**
+ * Write the profile of current MPI process, along with its message counters, to the given file as JSON.
+ * Returns false if the file cannot be written.
+ */
+bool actor::Profile::write(const std::string &filename, int rank, const mail::Counters &counters) const {
+
+    FILE *f = fopen(filename.c_str(), "w");
+    if (f == nullptr) {
+        return false;
+    }
+
+    auto elapsed = seconds();
+    fprintf(f, "{\n");
+    fprintf(f, "  \"rank\": %d,\n", rank);
+    fprintf(f, "  \"seconds\": %f,\n", elapsed);
+    fprintf(f, "  \"cycles\": %ld,\n", cycles);
+    fprintf(f, "  \"cycles_per_second\": %f,\n", elapsed > 0 ? static_cast<double>(cycles) / elapsed : 0.0);
+    fprintf(f, "  \"probes\": %ld,\n", counters.probes);
+    fprintf(f, "  \"probe_hits\": %ld,\n", counters.probe_hits);
+    fprintf(f, "  \"bsend_bytes\": %ld,\n", counters.bytes_sent);
+    fprintf(f, "  \"max_cycle_bsend_bytes\": %ld,\n", max_cycle_bytes);
+
+    fprintf(f, "  \"types\": [");
+    for (int i = 0; i < counters.sent_by_type.size(); i++) {
+        fprintf(f, "%s\n    {\"type\": %d, \"sent\": %ld, \"bytes_sent\": %ld, \"received\": %ld, \"bytes_received\": %ld}",
+                i == 0 ? "" : ",", i, counters.sent_by_type[i], counters.bytes_sent_by_type[i],
+                counters.received_by_type[i], counters.bytes_received_by_type[i]);
+    }
+    fprintf(f, "\n  ],\n");
+
+    fprintf(f, "  \"actors\": [");
+    auto first = true;
+    for (const auto &kv: actors) {
+        const auto &p = kv.second;
+        fprintf(f, "%s\n    {\"id\": %d, \"ingress_calls\": %ld, \"ingress_seconds\": %f, \"run_calls\": %ld, "
+                   "\"run_seconds\": %f, \"max_batch\": %d, \"backlogged_cycles\": %ld}",
+                first ? "" : ",", kv.first, p.ingress_calls,
+                static_cast<double>(p.ingress_nanoseconds) / NANOSECONDS_PER_SECOND, p.run_calls,
+                static_cast<double>(p.run_nanoseconds) / NANOSECONDS_PER_SECOND, p.max_batch, p.backlogged_cycles);
+        first = false;
+    }
+    fprintf(f, "\n  ]\n");
+    fprintf(f, "}\n");
+
+    return fclose(f) == 0;
+}
@@ -0,0 +1,95 @@
+#include "actor/snapshots.h"
+
+/**
+ * Close the snapshot file if still open, e.g. when the framework stops before running actors, so that the
+ * writer thread is never left running.
+ */
+actor::Snapshots::~Snapshots() {
+    close();
+}
+
+/**
+ * Create the snapshot file and start the writer thread. Returns false if the file cannot be created.
+ */
+bool actor::Snapshots::open(const std::string &filename) {
+
+    file = std::fopen(filename.c_str(), "w");
+    if (file == nullptr) {
+        return false;
+    }
+
+    writer = std::thread(&actor::Snapshots::write_buffers, this);
+    return true;
+}
+
+/**
+ * Append a record to the front buffer.
+ */
+void actor::Snapshots::write(const std::string &record) {
+    front += record;
+}
+
+/**
+ * Hand the front buffer over to the writer thread, unless it is empty or the writer thread has yet to write
+ * the previous one, in which case records stay in the front buffer until a later call.
+ */
+void actor::Snapshots::flush() {
+
+    if (file == nullptr || front.empty()) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!pending) {
+        front.swap(back);
+        pending = true;
+        ready.notify_one();
+    }
+}
+
+/**
+ * Write the remaining records, wait for the writer thread to exit and close the file.
+ */
+void actor::Snapshots::close() {
+
+    if (file == nullptr) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        closing = true;
+        ready.notify_one();
+    }
+
+    writer.join();
+    std::fclose(file);
+    file = nullptr;
+}
+
+/**
+ * Body of the writer thread. While pending, the back buffer belongs to the writer thread, which writes it
+ * without holding the lock. Once closing, the front buffer is no longer written by actors and is written last.
+ */
+void actor::Snapshots::write_buffers() {
+
+    while (true) {
+
+        std::unique_lock<std::mutex> lock(mutex);
+        ready.wait(lock, [this] { return pending || closing; });
+
+        if (pending) {
+            lock.unlock();
+            std::fwrite(back.data(), 1, back.size(), file);
+            std::fflush(file);
+            back.clear();
+            lock.lock();
+            pending = false;
+            continue;
+        }
+
+        std::fwrite(front.data(), 1, front.size(), file);
+        front.clear();
+        return;
+    }
+}
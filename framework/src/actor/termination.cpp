@@ -0,0 +1,8 @@
+#include "actor/termination.h"
+
+/**
+ * Request the global stop of all actors on all MPI processes.
+ */
+void actor::Termination::request() {
+    requested = true;
+}
@@ -0,0 +1,82 @@
+#include <algorithm>
+#include <cstdio>
+#include <ctime>
+#include "actor/trace.h"
+#include "actor/clock.h"
+
+/**
+ * Start recording events of current MPI process into a ring buffer of the given capacity.
+ */
+void actor::Trace::open(int trace_rank, long capacity) {
+    rank = trace_rank;
+    events.resize(std::max(1L, capacity));
+    num_events = 0;
+    enabled = true;
+}
+
+/**
+ * Record an event of the given actor, overwriting the oldest event once the ring buffer is full.
+ */
+void actor::Trace::record(trace_kind kind, actor::id id, unsigned long long flow) {
+
+    if (!enabled) {
+        return;
+    }
+
+    struct timespec time{};
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    auto &event = events[num_events % static_cast<long long>(events.size())];
+    event.nanoseconds = time.tv_sec * NANOSECONDS_PER_SECOND + time.tv_nsec;
+    event.flow = flow;
+    event.id = id;
+    event.kind = kind;
+    num_events++;
+}
+
+/**
+ * Returns the identifier of a message, given the sending actor and sequence number of its header, and the rank
+ * of its sender. Messages without a sending actor are identified by the rank of their sender instead.
+ */
+unsigned long long actor::Trace::flow_id(int sender, long sequence, int sender_rank) {
+    auto low = static_cast<unsigned long long>(static_cast<unsigned int>(sequence));
+    if (sender >= 0) {
+        return (1ULL << 63) | (static_cast<unsigned long long>(static_cast<unsigned int>(sender)) << 32) | low;
+    }
+    return (static_cast<unsigned long long>(static_cast<unsigned int>(sender_rank)) << 32) | low;
+}
+
+/**
+ * Returns the events kept in the ring buffer as comma-separated Chrome trace events, in microseconds since
+ * the given time on the monotonic clock, preceded by the name of the process of current rank.
+ */
+std::string actor::Trace::format(long long origin_nanoseconds) const {
+
+    auto capacity = static_cast<long long>(events.size());
+    auto first = num_events > capacity ? num_events - capacity : 0;
+
+    char line[256];
+    snprintf(line, sizeof(line),
+             "{\"name\": \"process_name\", \"ph\": \"M\", \"pid\": %d, \"tid\": 0, "
+             "\"args\": {\"name\": \"rank %d (%lld events dropped)\"}}", rank, rank, first);
+    std::string chunk = line;
+
+    for (auto i = first; i < num_events; i++) {
+        const auto &event = events[i % capacity];
+        auto ts = static_cast<double>(event.nanoseconds - origin_nanoseconds) / 1000;
+        if (event.kind == TRACE_SEND || event.kind == TRACE_RECEIVE) {
+            snprintf(line, sizeof(line),
+                     ",\n{\"name\": \"message\", \"cat\": \"message\", \"ph\": \"%s\", \"id\": \"%llx\", "
+                     "\"pid\": %d, \"tid\": %d, \"ts\": %.3f}",
+                     event.kind == TRACE_SEND ? "s" : "f", event.flow, rank, event.id, ts);
+        } else {
+            auto ingress = event.kind == TRACE_INGRESS_BEGIN || event.kind == TRACE_INGRESS_END;
+            auto begin = event.kind == TRACE_INGRESS_BEGIN || event.kind == TRACE_RUN_BEGIN;
+            snprintf(line, sizeof(line),
+                     ",\n{\"name\": \"%s\", \"cat\": \"actor\", \"ph\": \"%s\", \"pid\": %d, \"tid\": %d, \"ts\": %.3f}",
+                     ingress ? "ingress" : "run", begin ? "B" : "E", rank, event.id, ts);
+        }
+        chunk += line;
+    }
+
+    return chunk;
+}
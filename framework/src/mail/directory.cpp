@@ -0,0 +1,78 @@
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include "mail/directory.h"
+
+/**
+ * Returns the address of the i-th actor of the block.
+ */
+mail::Address mail::Directory::Block::address(int i) const {
+    auto slot = first_tag + i;
+    return mail::Address(first_rank + slot / actors_per_rank, slot % actors_per_rank);
+}
+
+mail::Directory::Directory() = default;
+
+/**
+ * Store the address of an actor explicitly, replacing its previous address if any.
+ * Inserting actors in increasing order of ID takes constant time.
+ */
+void mail::Directory::insert(actor::id id, mail::Address address) {
+
+    auto it = std::lower_bound(ids.begin(), ids.end(), id);
+    auto index = it - ids.begin();
+    if (it != ids.end() && *it == id) {
+        addresses[index] = address;
+        return;
+    }
+
+    ids.insert(it, id);
+    addresses.insert(addresses.begin() + index, address);
+}
+
+/**
+ * Store the address of an actor placed in blocks of `actors_per_rank` actors per MPI process.
+ * The actor extends the last block if its ID and address follow those of the block; otherwise it starts a new block.
+ */
+void mail::Directory::insertInBlock(actor::id id, mail::Address address, int actors_per_rank) {
+
+    if (!blocks.empty()) {
+        auto &block = blocks.back();
+        if (block.actors_per_rank == actors_per_rank
+            && block.first_id + block.count == id
+            && block.address(block.count) == address) {
+            block.count++;
+            return;
+        }
+    }
+
+    blocks.push_back(Block{id, 1, address.rank, address.tag, actors_per_rank});
+}
+
+/**
+ * Returns the address of an actor.
+ * Explicitly stored addresses take precedence over blocks, so that actors placed in blocks can change address.
+ * Throws std::out_of_range if the actor is unknown.
+ */
+mail::Address mail::Directory::at(actor::id id) const {
+
+    auto it = std::lower_bound(ids.begin(), ids.end(), id);
+    if (it != ids.end() && *it == id) {
+        return addresses[it - ids.begin()];
+    }
+
+    for (const auto &block: blocks) {
+        if (id >= block.first_id && id < block.first_id + block.count) {
+            return block.address(id - block.first_id);
+        }
+    }
+
+    throw std::out_of_range("unknown actor " + std::to_string(id));
+}
+
+/**
+ * Returns the number of bytes of memory used by the directory, excluding the object itself.
+ */
+int mail::Directory::memoryUsage() const {
+    return static_cast<int>(blocks.size() * sizeof(Block) + ids.size() * (sizeof(actor::id) + sizeof(Address)));
+}
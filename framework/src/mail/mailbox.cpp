@@ -1,6 +1,8 @@
 
 #include <iostream>
 #include <cstdlib>
+#include <cstring>
+#include <vector>
 #include "mail/mailbox.h"
 #include "mail/message.h"
 #include "actor/types.h"
@@ -20,6 +22,8 @@ mail::Mailbox::Mailbox(mail::Address address, mail::Context context) : address(a
 bool mail::Mailbox::hasMessage() const {
     int flag = 0;
     MPI_Iprobe(MPI_ANY_SOURCE, address.tag, MPI_COMM_WORLD, &flag, MPI_STATUS_IGNORE);
+    context.counters->probes++;
+    context.counters->probe_hits += flag != 0 ? 1 : 0;
     return flag != 0;
 }
 
@@ -29,30 +33,55 @@ bool mail::Mailbox::hasMessage() const {
  */
 mail::Message mail::Mailbox::receive() const {
 
-    // Receive payload metadata (i.e. data type and count)
-    auto metadata = new int[2];
+    // Receive payload metadata (i.e. data type, count and timestamp)
+    mail::Header header{};
     MPI_Status status_source;
-    MPI_Recv(metadata, 2, MPI_INT, MPI_ANY_SOURCE, address.tag, MPI_COMM_WORLD, &status_source);
+    MPI_Recv(&header, sizeof(mail::Header), MPI_BYTE, MPI_ANY_SOURCE, address.tag, MPI_COMM_WORLD, &status_source);
 
     auto source = status_source.MPI_SOURCE;  // Rank of sender
     auto tag = status_source.MPI_TAG;        // For a given rank, this tag identifies the sending actor
-    auto index = metadata[0];                // Identifies the datatype of the payload
-    auto count = metadata[1];                // Indicates the count of data elements received
-    delete[] metadata;
+    if (context.trace->enabled && header.anti == 0) {
+        context.trace->record(actor::TRACE_RECEIVE, context.trace->current,
+                              actor::Trace::flow_id(header.sender, header.sequence, source));
+    }
+    auto index = header.type_index;          // Identifies the datatype of the payload
+    auto count = header.count;               // Indicates the count of data elements received
 
     auto type = context.mail_types->at(index);
     auto mpi_datatype = type.mpi_datatype;     // MPI_Datatype of the payload
     auto size_datatype = type.size_bytes;      // The size of the MPI_Datatype
 
-    // Receive actual payload (i.e. array of MPI_Datatype)
+    // Receive actual payload (i.e. array of MPI_Datatype, or its encoding)
     void *data = malloc(size_datatype * count);
-    MPI_Recv(data, count, mpi_datatype, source, tag, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+    long size_payload = static_cast<long>(size_datatype) * count;
+    if (type.decode != nullptr) {
+        MPI_Status status_payload;
+        MPI_Probe(source, tag, MPI_COMM_WORLD, &status_payload);
+        int size;
+        MPI_Get_count(&status_payload, MPI_BYTE, &size);
+        std::vector<char> bytes(size);
+        MPI_Recv(bytes.data(), size, MPI_BYTE, source, tag, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+        type.decode(bytes.data(), size, data, count);
+        size_payload = size;
+    } else {
+        MPI_Recv(data, count, mpi_datatype, source, tag, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+    }
 
     // Return message
     mail::Message message;
     message.count = count;
     message.data = data;
     message.mpi_datatype = mpi_datatype;
+    message.timestamp = header.timestamp;
+    message.sender = header.sender;
+    message.sequence = header.sequence;
+    message.anti = header.anti == 1;
+    context.counters->received++;
+    context.counters->received_from[source]++;
+    if (header.anti == 0) {
+        context.counters->received_by_type[index]++;
+        context.counters->bytes_received_by_type[index] += size_payload;
+    }
 
     return message;
 }
@@ -78,11 +107,116 @@ void mail::Mailbox::send(Message &message, actor::id to) const {
         return;
     }
 
-    // Send metadata payload (i.e data type and count), followed by the actual payload
+    // Encode payload, if its type provides an encoder
+    auto &type = context.mail_types->at(index);
+    std::vector<char> bytes;
+    if (type.encode != nullptr) {
+        type.encode(message.data, message.count, bytes);
+    }
+
+    // Record message
+    auto header = mail::Header{index, message.count, message.timestamp, -1, 0, 0};
+    if (journal != nullptr) {
+        header.sender = journal->sender;
+        header.sequence = journal->next_sequence++;
+        journal->sent.push_back(mail::Sent{to, header.sequence, message.timestamp, journal->batch});
+    }
+    if (outbox != nullptr) {
+        header.sender = outbox->sender;
+        header.sequence = outbox->next_sequence++;
+    }
+
+    // Trace message, numbering it on current MPI process unless its sender records it
+    if (context.trace->enabled) {
+        if (header.sender < 0) {
+            header.sequence = context.trace->next_sequence++;
+        }
+        context.trace->record(actor::TRACE_SEND, context.trace->current,
+                              actor::Trace::flow_id(header.sender, header.sequence, context.trace->rank));
+    }
+
     auto to_address = context.id_to_address->at(to);
-    std::vector<int> metadata = {index, message.count};
-    MPI_Bsend(metadata.data(), (int) metadata.size(), MPI_INT, to_address.rank, to_address.tag, MPI_COMM_WORLD);
-    MPI_Bsend(message.data, message.count, message.mpi_datatype, to_address.rank, to_address.tag, MPI_COMM_WORLD);
+    auto size_payload = type.encode != nullptr ? static_cast<long>(bytes.size())
+                                               : static_cast<long>(type.size_bytes) * message.count;
+    context.counters->sent++;
+    context.counters->sent_to[to_address.rank]++;
+    context.counters->sent_by_type[index]++;
+    context.counters->bytes_sent_by_type[index] += size_payload;
+
+    // Buffer message in the outbox, to be exchanged by the framework
+    if (outbox != nullptr) {
+        int max_size = static_cast<int>(bytes.size());
+        if (type.encode == nullptr) {
+            MPI_Pack_size(message.count, message.mpi_datatype, MPI_COMM_WORLD, &max_size);
+        }
+        auto &buffer = outbox->buffers[to_address.rank];
+        auto offset = buffer.size();
+        auto payload_offset = offset + sizeof(mail::Header) + 2 * sizeof(int);
+        buffer.resize(payload_offset + max_size);
+
+        int size = 0;
+        if (type.encode != nullptr) {
+            std::memcpy(buffer.data() + payload_offset, bytes.data(), bytes.size());
+            size = max_size;
+        } else {
+            MPI_Pack(message.data, message.count, message.mpi_datatype, buffer.data() + payload_offset, max_size,
+                     &size, MPI_COMM_WORLD);
+        }
+        std::memcpy(buffer.data() + offset, &header, sizeof(mail::Header));
+        std::memcpy(buffer.data() + offset + sizeof(mail::Header), &to_address.tag, sizeof(int));
+        std::memcpy(buffer.data() + offset + sizeof(mail::Header) + sizeof(int), &size, sizeof(int));
+        buffer.resize(payload_offset + size);
+        return;
+    }
+
+    // Send metadata payload (i.e data type, count and timestamp), followed by the actual payload
+    context.counters->bytes_sent += static_cast<long>(sizeof(mail::Header)) + size_payload;
+    MPI_Bsend(&header, sizeof(mail::Header), MPI_BYTE, to_address.rank, to_address.tag, MPI_COMM_WORLD);
+    if (type.encode != nullptr) {
+        MPI_Bsend(bytes.data(), static_cast<int>(bytes.size()), MPI_BYTE, to_address.rank, to_address.tag,
+                  MPI_COMM_WORLD);
+    } else {
+        MPI_Bsend(message.data, message.count, message.mpi_datatype, to_address.rank, to_address.tag,
+                  MPI_COMM_WORLD);
+    }
+}
+
+/**
+ * Sends a message to an actor specified by its id. If the framework reduces the messages of this type to
+ * this actor (see `ParallelActorModel::addReduction`), the message is added to the sum of the messages sent by
+ * actors of current MPI process instead, to be delivered with the next reduction.
+ */
+void mail::Mailbox::reduce(Message &message, actor::id to) const {
+
+    if (context.reductions != nullptr) {
+        for (auto &reduction: *context.reductions) {
+            auto &type = context.mail_types->at(reduction.type_index);
+            if (reduction.to == to && type.mpi_datatype == message.mpi_datatype) {
+                auto values = static_cast<const int *>(message.data);
+                auto size = reduction.sum.size();
+                for (int i = 0; i < message.count * size; i++) {
+                    reduction.sum[i % size] += values[i];
+                }
+                return;
+            }
+        }
+    }
+
+    send(message, to);
+}
+
+/**
+ * Send an anti-message cancelling a recorded message, i.e. a header without payload.
+ */
+void mail::Mailbox::cancel(const mail::Sent &sent) const {
+
+    auto to_address = context.id_to_address->at(sent.to);
+    auto header = mail::Header{0, 0, sent.timestamp, journal->sender, sent.sequence, 1};
+    auto mpi_datatype = context.mail_types->at(0).mpi_datatype;
+    MPI_Bsend(&header, sizeof(mail::Header), MPI_BYTE, to_address.rank, to_address.tag, MPI_COMM_WORLD);
+    MPI_Bsend(NULL, 0, mpi_datatype, to_address.rank, to_address.tag, MPI_COMM_WORLD);
+    context.counters->sent++;
+    context.counters->sent_to[to_address.rank]++;
 }
 
 mail::Mailbox::~Mailbox() {}
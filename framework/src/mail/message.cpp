@@ -14,7 +14,7 @@ bool mail::Address::operator==(const mail::Address &other) const {
 mail::Message::Message() = default;
 
 mail::Message::Message(void *data, int count, MPI_Datatype mpi_datatype) :
-        data(data), count(count), mpi_datatype(mpi_datatype) {}
+        data(data), count(count), mpi_datatype(mpi_datatype), timestamp(0), sender(-1), sequence(0), anti(false) {}
 
 /**
  * Free data of message.
@@ -0,0 +1,106 @@
+#ifndef ACTORS_H
+#define ACTORS_H
+
+#include <string>
+#include <vector>
+#include "actor/actor.h"
+
+/**
+ * Sends pings of a given payload to a Ponger and times the round trips, once warmed up.
+ */
+class Pinger : public actor::Actor {
+public:
+    actor::id peer;
+    std::vector<char> payload;
+    int round_trips;
+    int warmup_round_trips;
+    int completed = 0;
+    bool started = false;
+    double start_time = 0;
+    std::string parameters;
+
+    Pinger(int id, actor::id peer, int payload_bytes, int round_trips, const std::string &parameters);
+
+    actor::next_step ingress(mail::Message &message) override;
+
+    actor::next_step run() override;
+
+    void ping();
+};
+
+/**
+ * Sends every ping back to the Pinger, and stops after the given number of pings.
+ */
+class Ponger : public actor::Actor {
+public:
+    actor::id peer;
+    int round_trips;
+    int received = 0;
+
+    Ponger(int id, actor::id peer, int round_trips);
+
+    actor::next_step ingress(mail::Message &message) override;
+
+    actor::next_step run() override;
+};
+
+/**
+ * Sends messages of a given payload to a Receiver in windows of `batch` messages, sending the next window
+ * once the Receiver acknowledged the previous one.
+ */
+class Sender : public actor::Actor {
+public:
+    actor::id peer;
+    std::vector<char> payload;
+    int batch;
+    int messages;
+    int sent = 0;
+    int acknowledged = 0;
+    double start_time = 0;
+    std::string parameters;
+
+    Sender(int id, actor::id peer, int payload_bytes, int batch, int messages, const std::string &parameters);
+
+    actor::next_step ingress(mail::Message &message) override;
+
+    actor::next_step run() override;
+};
+
+/**
+ * Receives the messages of a Sender and acknowledges each window of `batch` messages. With global termination,
+ * it stops all actors once it received all messages, and reports the time spent per message.
+ */
+class Receiver : public actor::Actor {
+public:
+    actor::id peer;
+    int batch;
+    int messages;
+    int received = 0;
+    double start_time = 0;
+    std::string parameters;
+
+    Receiver(int id, actor::id peer, int batch, int messages, const std::string &parameters);
+
+    actor::next_step ingress(mail::Message &message) override;
+
+    actor::next_step run() override;
+};
+
+/**
+ * Does nothing until the given number of seconds elapsed, or until all actors stop if no duration is given.
+ * When reporting, it reports the execution cycles of its MPI process.
+ */
+class IdleActor : public actor::Actor {
+public:
+    double seconds;
+    int actors_per_proc;
+    bool reporting;
+    long runs = 0;
+    std::string parameters;
+
+    IdleActor(int id, double seconds, int actors_per_proc, bool reporting, const std::string &parameters);
+
+    actor::next_step run() override;
+};
+
+#endif
@@ -0,0 +1,20 @@
+#ifndef BENCHMARKS_H
+#define BENCHMARKS_H
+
+#include <string>
+
+#define PING_PONG_ROUND_TRIPS 10000     // Default number of round trips of the ping-pong benchmark
+#define THROUGHPUT_MESSAGES 100000      // Default number of messages of the throughput benchmark
+#define IDLE_SECONDS 1.0                // Default duration of the idle benchmark
+#define INGRESS_MESSAGES 100000         // Default number of messages of the ingress benchmark
+#define INGRESS_BATCH 256               // Messages sent per window in the ingress benchmark
+
+bool ping_pong(const std::string &placement, int payload_bytes, int round_trips);
+
+bool throughput(int payload_bytes, int batch, int messages);
+
+bool idle(int actors_per_proc, double seconds);
+
+bool ingress(int max_num_message_per_iteration, int idle_actors, int messages);
+
+#endif
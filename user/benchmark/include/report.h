@@ -0,0 +1,10 @@
+#ifndef REPORT_H
+#define REPORT_H
+
+#include <string>
+
+#define CSV_HEADER "benchmark,procs,parameters,metric,value"
+
+void report(const std::string &benchmark, const std::string &parameters, const std::string &metric, double value);
+
+#endif
@@ -0,0 +1,30 @@
+#!/bin/sh
+# Run the benchmark suite, printing the results of all benchmarks as a single CSV to stdout.
+# LAUNCHER starts the MPI processes, e.g. "mpiexec -n 2" or "srun", and EXE names the benchmark program.
+
+LAUNCHER=${LAUNCHER:-"mpiexec -n 2"}
+EXE=${EXE:-build/benchmark}
+
+${LAUNCHER} ${EXE} header
+
+for placement in same different; do
+    for payload_bytes in 8 1024 65536; do
+        ${LAUNCHER} ${EXE} ping_pong ${placement} ${payload_bytes}
+    done
+done
+
+for payload_bytes in 8 1024 16384; do
+    for batch in 1 16 256; do
+        ${LAUNCHER} ${EXE} throughput ${payload_bytes} ${batch}
+    done
+done
+
+for actors_per_proc in 1 16 256 4096; do
+    ${LAUNCHER} ${EXE} idle ${actors_per_proc}
+done
+
+for max_num_message_per_iteration in 1 4 20 100; do
+    for idle_actors in 0 64; do
+        ${LAUNCHER} ${EXE} ingress ${max_num_message_per_iteration} ${idle_actors}
+    done
+done
@@ -0,0 +1,186 @@
+#include <algorithm>
+#include "mpi.h"
+#include "actor/clock.h"
+#include "actors.h"
+#include "report.h"
+
+/**
+ * Send a message of the given payload, as bytes.
+ */
+static void send_bytes(mail::Mailbox &mailbox, std::vector<char> &payload, actor::id to) {
+    mail::Message message;
+    message.count = static_cast<int>(payload.size());
+    message.mpi_datatype = MPI_BYTE;
+    message.data = payload.data();
+    mailbox.send(message, to);
+}
+
+/*************************************************************************
+ * Pinger                                                                *
+ *************************************************************************/
+
+Pinger::Pinger(int id, actor::id peer, int payload_bytes, int round_trips, const std::string &parameters)
+        : Actor(id), peer(peer), payload(payload_bytes), round_trips(round_trips),
+          warmup_round_trips(round_trips / 10), parameters(parameters) {}
+
+/**
+ * Receive a pong, and send the next ping until all round trips completed. The round trips of the warmup
+ * are not timed.
+ */
+actor::next_step Pinger::ingress(mail::Message &message) {
+
+    completed++;
+    if (completed == warmup_round_trips) {
+        start_time = MPI_Wtime();
+    }
+
+    if (completed == round_trips) {
+        auto seconds = MPI_Wtime() - start_time;
+        report("ping_pong", parameters, "round_trip_us", 1e6 * seconds / (round_trips - warmup_round_trips));
+        return actor::STOP;
+    }
+
+    ping();
+    return actor::CONTINUE;
+}
+
+actor::next_step Pinger::run() {
+
+    if (!started) {
+        started = true;
+        start_time = MPI_Wtime();
+        ping();
+    }
+
+    return actor::CONTINUE;
+}
+
+void Pinger::ping() {
+    send_bytes(mailbox, payload, peer);
+}
+
+/*************************************************************************
+ * Ponger                                                                *
+ *************************************************************************/
+
+Ponger::Ponger(int id, actor::id peer, int round_trips) : Actor(id), peer(peer), round_trips(round_trips) {}
+
+actor::next_step Ponger::ingress(mail::Message &message) {
+    mailbox.send(message, peer);
+    received++;
+    return received == round_trips ? actor::STOP : actor::CONTINUE;
+}
+
+actor::next_step Ponger::run() {
+    return actor::CONTINUE;
+}
+
+/*************************************************************************
+ * Sender                                                                *
+ *************************************************************************/
+
+Sender::Sender(int id, actor::id peer, int payload_bytes, int batch, int messages, const std::string &parameters)
+        : Actor(id), peer(peer), payload(payload_bytes), batch(batch), messages(messages), parameters(parameters) {}
+
+/**
+ * Receive the acknowledgement of a window, and report the throughput once all messages are acknowledged.
+ */
+actor::next_step Sender::ingress(mail::Message &message) {
+
+    acknowledged += std::min(batch, messages - acknowledged);
+    if (acknowledged < messages) {
+        return actor::CONTINUE;
+    }
+
+    if (!parameters.empty()) {
+        auto seconds = MPI_Wtime() - start_time;
+        report("throughput", parameters, "messages_per_second", messages / seconds);
+        report("throughput", parameters, "megabytes_per_second",
+               static_cast<double>(messages) * static_cast<double>(payload.size()) / seconds / 1e6);
+    }
+    return actor::STOP;
+}
+
+/**
+ * Send the next window of messages once the previous one is acknowledged.
+ */
+actor::next_step Sender::run() {
+
+    if (sent == 0) {
+        start_time = MPI_Wtime();
+    }
+
+    if (sent < messages && sent == acknowledged) {
+        auto window = std::min(batch, messages - sent);
+        for (int i = 0; i < window; i++) {
+            send_bytes(mailbox, payload, peer);
+        }
+        sent += window;
+    }
+
+    return actor::CONTINUE;
+}
+
+/*************************************************************************
+ * Receiver                                                              *
+ *************************************************************************/
+
+Receiver::Receiver(int id, actor::id peer, int batch, int messages, const std::string &parameters)
+        : Actor(id), peer(peer), batch(batch), messages(messages), parameters(parameters) {}
+
+/**
+ * Receive a message, acknowledging each complete window. Once all messages are received, report the time
+ * spent per message, if reporting, and stop all actors, with global termination.
+ */
+actor::next_step Receiver::ingress(mail::Message &message) {
+
+    if (received == 0) {
+        start_time = MPI_Wtime();
+    }
+
+    received++;
+    if (received % batch == 0 || received == messages) {
+        std::vector<char> ack(1);
+        send_bytes(mailbox, ack, peer);
+    }
+
+    if (received < messages) {
+        return actor::CONTINUE;
+    }
+
+    if (!parameters.empty()) {
+        report("ingress", parameters, "ns_per_message", 1e9 * (MPI_Wtime() - start_time) / messages);
+    }
+    if (termination != nullptr) {
+        termination->request();
+    }
+    return actor::STOP;
+}
+
+actor::next_step Receiver::run() {
+    return actor::CONTINUE;
+}
+
+/*************************************************************************
+ * IdleActor                                                             *
+ *************************************************************************/
+
+IdleActor::IdleActor(int id, double seconds, int actors_per_proc, bool reporting, const std::string &parameters)
+        : Actor(id), seconds(seconds), actors_per_proc(actors_per_proc), reporting(reporting),
+          parameters(parameters) {}
+
+actor::next_step IdleActor::run() {
+
+    runs++;
+    if (seconds <= 0 || clock.wall_time < static_cast<long long>(seconds * NANOSECONDS_PER_SECOND)) {
+        return actor::CONTINUE;
+    }
+
+    if (reporting) {
+        auto wall_seconds = static_cast<double>(clock.wall_time) / NANOSECONDS_PER_SECOND;
+        report("idle", parameters, "cycles_per_second", static_cast<double>(runs) / wall_seconds);
+        report("idle", parameters, "ns_per_actor_per_cycle",
+               static_cast<double>(clock.wall_time) / (static_cast<double>(runs) * actors_per_proc));
+    }
+    return actor::STOP;
+}
@@ -0,0 +1,189 @@
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include "mpi.h"
+#include "actor/framework.h"
+#include "actors.h"
+#include "benchmarks.h"
+#include "report.h"
+
+/**
+ * Microbenchmarks of the mailbox and of the execution cycle of the framework.
+ *
+ * Each run executes one benchmark with the given parameters, on a single framework instance, and rank 0 prints
+ * its results as CSV rows (see CSV_HEADER). The script jobs/benchmark.sh runs the whole suite.
+ *
+ *     benchmark ping_pong <same|different> <payload_bytes> [round_trips]
+ *     benchmark throughput <payload_bytes> <batch> [messages]
+ *     benchmark idle <actors_per_proc> [seconds]
+ *     benchmark ingress <max_num_message_per_iteration> <idle_actors> [messages]
+ */
+
+static void print_usage() {
+    fprintf(stderr, "usage: benchmark ping_pong <same|different> <payload_bytes> [round_trips]\n");
+    fprintf(stderr, "       benchmark throughput <payload_bytes> <batch> [messages]\n");
+    fprintf(stderr, "       benchmark idle <actors_per_proc> [seconds]\n");
+    fprintf(stderr, "       benchmark ingress <max_num_message_per_iteration> <idle_actors> [messages]\n");
+    fprintf(stderr, "       benchmark header\n");
+}
+
+int main(int argc, char *argv[]) {
+
+    MPI_Init(&argc, &argv);
+
+    int rank;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+    std::string name = argc > 1 ? argv[1] : "";
+    auto success = true;
+    if (name == "header") {
+        if (rank == 0) {
+            printf("%s\n", CSV_HEADER);
+        }
+    } else if (name == "ping_pong" && argc >= 4) {
+        success = ping_pong(argv[2], atoi(argv[3]), argc > 4 ? atoi(argv[4]) : PING_PONG_ROUND_TRIPS);
+    } else if (name == "throughput" && argc >= 4) {
+        success = throughput(atoi(argv[2]), atoi(argv[3]), argc > 4 ? atoi(argv[4]) : THROUGHPUT_MESSAGES);
+    } else if (name == "idle" && argc >= 3) {
+        success = idle(atoi(argv[2]), argc > 3 ? atof(argv[3]) : IDLE_SECONDS);
+    } else if (name == "ingress" && argc >= 4) {
+        success = ingress(atoi(argv[2]), atoi(argv[3]), argc > 4 ? atoi(argv[4]) : INGRESS_MESSAGES);
+    } else {
+        if (rank == 0) {
+            print_usage();
+        }
+        success = false;
+    }
+
+    MPI_Finalize();
+
+    return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/**
+ * Returns the number of MPI processes, printing an error unless there are at least the given number.
+ */
+static int require_procs(int min_procs) {
+    int num_procs;
+    MPI_Comm_size(MPI_COMM_WORLD, &num_procs);
+    if (num_procs < min_procs) {
+        fprintf(stderr, "ERROR: this benchmark requires at least %d MPI processes\n", min_procs);
+    }
+    return num_procs;
+}
+
+/**
+ * Returns false, printing an error, if a window of messages of the given payload may not fit in the buffer
+ * attached for MPI_Bsend. Each message is buffered as a header and a payload.
+ */
+static bool fits_in_buffer(int payload_bytes, int batch) {
+    auto bytes = static_cast<long>(batch) * (2 * MPI_BSEND_OVERHEAD + sizeof(mail::Header) + payload_bytes);
+    if (bytes > MPI_BUFFER_SIZE) {
+        fprintf(stderr, "ERROR: a window of %d messages of %d bytes exceeds the MPI_Bsend buffer\n", batch,
+                payload_bytes);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Latency of messages between two actors on the same MPI process or on different MPI processes: a Pinger
+ * sends pings to a Ponger, which sends them back.
+ */
+bool ping_pong(const std::string &placement, int payload_bytes, int round_trips) {
+
+    auto same = placement == "same";
+    if ((!same && placement != "different") || payload_bytes < 1 || round_trips < 10) {
+        fprintf(stderr, "ERROR: invalid ping_pong parameters\n");
+        return false;
+    }
+    if (!same && require_procs(2) < 2) {
+        return false;
+    }
+
+    auto parameters = "placement=" + placement + ";payload_bytes=" + std::to_string(payload_bytes);
+    auto framework = ParallelActorModel(same ? 2 : 1, true);
+    framework.addType(mail::Type{sizeof(char), MPI_BYTE});
+    framework.addActor(new Pinger(0, 1, payload_bytes, round_trips, parameters));
+    framework.addActor(new Ponger(1, 0, round_trips));
+    framework.start();
+
+    return true;
+}
+
+/**
+ * Throughput of messages between actors on different MPI processes: a Sender sends windows of `batch`
+ * messages, each acknowledged by the Receiver before the next one.
+ */
+bool throughput(int payload_bytes, int batch, int messages) {
+
+    if (payload_bytes < 1 || batch < 1 || messages < batch) {
+        fprintf(stderr, "ERROR: invalid throughput parameters\n");
+        return false;
+    }
+    if (require_procs(2) < 2 || !fits_in_buffer(payload_bytes, batch)) {
+        return false;
+    }
+
+    auto parameters = "payload_bytes=" + std::to_string(payload_bytes) + ";batch=" + std::to_string(batch);
+    auto framework = ParallelActorModel(1, true);
+    framework.addType(mail::Type{sizeof(char), MPI_BYTE});
+    framework.addActor(new Sender(0, 1, payload_bytes, batch, messages, parameters));
+    framework.addActor(new Receiver(1, 0, batch, messages, ""));
+    framework.start();
+
+    return true;
+}
+
+/**
+ * Overhead of the execution cycle per idle actor: every MPI process runs the given number of actors that do
+ * nothing, in ingress mode, so that each execution cycle probes the mailbox of every actor.
+ */
+bool idle(int actors_per_proc, double seconds) {
+
+    if (actors_per_proc < 1 || seconds <= 0) {
+        fprintf(stderr, "ERROR: invalid idle parameters\n");
+        return false;
+    }
+
+    auto num_procs = require_procs(1);
+    auto parameters = "actors_per_proc=" + std::to_string(actors_per_proc);
+    auto framework = ParallelActorModel(actors_per_proc, true);
+    framework.addType(mail::Type{sizeof(char), MPI_BYTE});
+    for (int id = 0; id < actors_per_proc * num_procs; id++) {
+        framework.addActor(new IdleActor(id, seconds, actors_per_proc, id == 0, parameters));
+    }
+    framework.start();
+
+    return true;
+}
+
+/**
+ * Cost of receiving messages via `ingress` depending on the maximum number of messages received per actor
+ * in one execution cycle: a Receiver shares its MPI process with the given number of idle actors, and receives
+ * messages from a Sender on another MPI process. The Receiver stops all actors once it received all messages.
+ */
+bool ingress(int max_num_message_per_iteration, int idle_actors, int messages) {
+
+    if (max_num_message_per_iteration < 1 || idle_actors < 0 || messages < INGRESS_BATCH) {
+        fprintf(stderr, "ERROR: invalid ingress parameters\n");
+        return false;
+    }
+    if (require_procs(2) < 2) {
+        return false;
+    }
+
+    auto parameters = "max_num_message_per_iteration=" + std::to_string(max_num_message_per_iteration) +
+                      ";idle_actors=" + std::to_string(idle_actors);
+    auto framework = ParallelActorModel(idle_actors + 1, true, false, max_num_message_per_iteration);
+    framework.addType(mail::Type{sizeof(char), MPI_BYTE});
+    framework.addActor(new Receiver(0, 1, INGRESS_BATCH, messages, parameters));
+    for (int i = 0; i < idle_actors; i++) {
+        framework.addActor(new IdleActor(2 + i, 0, idle_actors + 1, false, ""));
+    }
+    framework.addActor(new Sender(1, 0, sizeof(char), INGRESS_BATCH, messages, ""));
+    framework.enableTermination();
+    framework.start();
+
+    return true;
+}
@@ -0,0 +1,14 @@
+#include <cstdio>
+#include "mpi.h"
+#include "report.h"
+
+/**
+ * Print a result as a CSV row (see CSV_HEADER), where parameters are given as `key=value` pairs separated
+ * by semicolons, so that results of successive runs can be concatenated and compared.
+ */
+void report(const std::string &benchmark, const std::string &parameters, const std::string &metric, double value) {
+    int num_procs;
+    MPI_Comm_size(MPI_COMM_WORLD, &num_procs);
+    printf("%s,%d,%s,%s,%f\n", benchmark.c_str(), num_procs, parameters.c_str(), metric.c_str(), value);
+    fflush(stdout);
+}
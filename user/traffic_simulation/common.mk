@@ -10,4 +10,13 @@ TRAFFIC_SRC = src/main.cpp src/*/*.cpp
 
 SRC = ${TRAFFIC_SRC} ${FRAMEWORK_SRC}
 INCLUDE = -I ${FRAMEWORK_H} -I ${TRAFFIC_H}
+# Overrides of constants, e.g. DEFINES=-DTIME_MODE=actor::BSP
+DEFINES =
+# Instruction set of local builds, which enables the AVX2 fuel check of data::Vehicles on capable CPUs.
+# ARCHER2 builds target the compute nodes via the Cray wrappers. ARCH_FLAGS= builds the scalar version.
+ARCH_FLAGS = -march=native
 EXE = build/traffic_simulation_program
+
+# Converter of binary results to text
+CONVERTER_SRC = tools/convert_results.cpp src/payload/results.cpp src/payload/summary.cpp
+CONVERTER_EXE = build/convert_results
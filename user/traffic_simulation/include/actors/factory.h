@@ -1,10 +1,12 @@
 #ifndef FACTORY_H
 #define FACTORY_H
 
+#include <map>
 #include <unordered_map>
 #include <vector>
 #include "actor/actor.h"
 #include "util/timer.h"
+#include "util/random.h"
 #include "map/graph.h"
 #include "payload/vehicle.h"
 #include "util/disjoint_set.h"
@@ -30,6 +32,9 @@ namespace actor {
         DisjointSet disjoint_set;            // Used to efficiently generate valid source and destination junctions
         std::unordered_map<int, std::vector<int>> components;
         Timer timer;                         // Timer for computing simulated minutes
+        std::multimap<double, int> exiting_vehicles;  // In logical time, vehicles removed by time of removal
+        double terminate_time = NO_EVENT;    // In logical time, time at which the simulation ends
+        RandomGenerator generator;           // Random number generator of this actor
 
     public:
 
@@ -44,8 +49,22 @@ namespace actor {
 
         next_step run() override;
 
+        double next_event_time() override;
+
+        double lookahead() override;
+
+        std::vector<actor::id> channels() override;
+
+        bool checkpoint(Serializer &serializer) override;
+
+        bool restore(Deserializer &deserializer) override;
+
     private:
 
+        bool load_road_map();
+
+        void add_vehicles(double timestamp);
+
         void generate_vehicles(std::unordered_map<int, std::vector<payload::Vehicle>> &vehicles_by_junction,
                                int number_vehicles);
 
@@ -53,9 +72,10 @@ namespace actor {
 
         void assign_source_and_destination(int &source, int &dest);
 
-        void send_vehicles(std::unordered_map<int, std::vector<payload::Vehicle>> &vehicles_by_junction);
+        void send_vehicles(std::unordered_map<int, std::vector<payload::Vehicle>> &vehicles_by_junction,
+                           double timestamp);
 
-        void send_statistics_to_summary(int number_vehicles);
+        void send_statistics_to_summary(int number_vehicles, double timestamp);
     };
 }
 
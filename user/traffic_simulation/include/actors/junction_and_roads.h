@@ -2,15 +2,18 @@
 #define JUNCTION_H
 
 #include <string>
+#include <map>
 #include "actor/actor.h"
 #include "actor/types.h"
 #include "actors/junction_and_roads.h"
 #include "mail/mailbox.h"
 #include "map/data.h"
 #include "map/graph.h"
+#include "map/vehicles.h"
 #include "payload/vehicle.h"
 #include "payload/summary.h"
 #include "util/timer.h"
+#include "util/random.h"
 #include "util/disjoint_set.h"
 #include "map/load.h"
 
@@ -32,9 +35,18 @@ namespace actor {
         graph::RoadMap road_map;                    // Road network
         data::Junction junction;                    // Current junction
         data::Roads roads;                          // Outgoing roads of current junction
-        payload::Vehicles vehicles;                 // Vehicles waiting on this junction or on one of its roads
+        data::Vehicles vehicles;                    // Vehicles waiting on this junction
+        data::Vehicles road_vehicles;               // Vehicles on the outgoing roads of this junction
+        std::vector<std::vector<data::RoadEvent>> road_events;  // Min-heap of the next events of vehicles on each road
+        std::vector<char> exhausted;                // Waiting vehicles that ran out of fuel, flagged on each run
         payload::PeriodicSummary periodic_summary;  // Data to be sent to summary actor periodically
         Timer timer;                                // timer for computing simulated minutes
+        int current_seconds;                        // Time at which vehicles are currently moved, in whole seconds
+        double current_time;                        // Time at which vehicles are currently moved
+        std::multimap<int, payload::Vehicle> arriving_vehicles;  // In logical time, vehicles by time of arrival
+        double terminate_time = NO_EVENT;           // In logical time, time at which the simulation ends
+        int next_snapshot_minutes = 0;              // Simulated minutes at which the next snapshot is due
+        RandomGenerator generator;                  // Random number generator of this actor
 
     public:
 
@@ -49,6 +61,20 @@ namespace actor {
 
         next_step run() override;
 
+        double next_event_time() override;
+
+        double lookahead() override;
+
+        std::vector<actor::id> channels() override;
+
+        double channel_lookahead(actor::id to) override;
+
+        bool serialize(Serializer &serializer) override;
+
+        bool deserialize(Deserializer &deserializer) override;
+
+        next_step terminate() override;
+
     private:
 
         int generate_vehicle_destination(int source, DisjointSet &disjoint_set,
@@ -56,9 +82,17 @@ namespace actor {
 
         void process_vehicles(mail::Message &message);
 
+        void receive_vehicle(payload::Vehicle &vehicle);
+
+        void process_events(int seconds);
+
+        void process_waiting_vehicles();
+
+        void process_road_events(double time);
+
         void switch_enabled_road_at_traffic_light();
 
-        void remove_vehicle_due_to_fuel_exhaustion(int i);
+        void remove_vehicle_due_to_fuel_exhaustion(const data::Vehicles &table, int i);
 
         int compute_road_speed(data::Road *road);
 
@@ -70,9 +104,13 @@ namespace actor {
 
         bool vehicle_exits_junction_without_traffic_lights(int i);
 
-        void vehicle_enters_road(int i);
+        int vehicle_enters_road(int i);
+
+        void update_current_time();
 
-        void move_vehicle_along_road(int i);
+        double arrival_time(int i);
+
+        void send_vehicle_to_next_junction(int i, int arrival_seconds);
 
         void vehicle_exits_road(int i);
 
@@ -82,7 +120,11 @@ namespace actor {
 
         void send_statistics(payload::PeriodicSummary &summary);
 
+        void write_snapshot();
+
         void send_final_summaries();
+
+        void write_final_summaries();
     };
 
 }
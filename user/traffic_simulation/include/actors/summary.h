@@ -1,6 +1,7 @@
 #ifndef SUMMARY_H
 #define SUMMARY_H
 
+#include <map>
 #include "actor/actor.h"
 #include "payload/summary.h"
 #include "util/timer.h"
@@ -25,10 +26,11 @@ namespace actor {
         int crashed_vehicles;               // Number of vehicles that crashed
         int exhausted_vehicles;             // Number of vehicles that ran out of fuel
         int remaining_detailed_summaries;   // Current number detailed summaries to be received
-        bool termination_sent;              // True when termination message has been sent to all actors
+        bool termination_sent;              // True when all actors have been told to terminate
         std::vector<payload::JunctionSummary> junction_summaries;       // Summaries for all junction
         std::vector<std::vector<payload::RoadSummary>> road_summaries;  // Summaries for all road
         Timer timer;                        // Timer for simulated minutes
+        std::multimap<double, payload::PeriodicSummary> pending_summaries;  // In logical time, summaries by time
 
     public:
         Summary(actor::id id, int factory_id, int num_junctions, int initial_vehicles, int max_mins);
@@ -41,8 +43,24 @@ namespace actor {
 
         next_step run() override;
 
+        double next_event_time() override;
+
+        double lookahead() override;
+
+        std::vector<actor::id> channels() override;
+
+        next_step terminate() override;
+
+        bool checkpoint(Serializer &serializer) override;
+
+        bool restore(Deserializer &deserializer) override;
+
     private:
 
+        void add_periodic_summary(const payload::PeriodicSummary &summary);
+
+        void print_progress();
+
         void send_terminate();
 
         void write_detailed_info();
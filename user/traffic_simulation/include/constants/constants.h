@@ -43,6 +43,29 @@
 #define MAX_NEW_VEHICLES 200
 
 #define LOG_DEBUG 0
+#define TOPOLOGY_AWARE_PLACEMENT 1
+#define WEIGHTED_PLACEMENT 1
+#define DYNAMIC_MIGRATION 1
+#ifndef TIME_MODE
+#define TIME_MODE actor::REAL_TIME   // actor::WINDOWED, actor::NULL_MESSAGES, actor::OPTIMISTIC or actor::BSP run in logical time
+#endif
+#define MIN_TRAVEL_SECONDS 1         // In logical time, minimum delay of a vehicle on a road and of any message
+#define COMPACT_VEHICLES 1           // Vehicles are sent as variable-width deltas rather than as MPI_VEHICLE
+#define REDUCED_STATISTICS 1         // In real time, statistics are summed by the framework before delivery
+#define REPLICATED_COUNTERS 1        // In real time, statistics are kept in counters replicated by the framework
+#define PARALLEL_RESULTS 1           // Junction actors write the results file collectively with MPI-IO
+#define BINARY_RESULTS 0             // With PARALLEL_RESULTS, results are written by columns to results.bin,
+                                     // which build/convert_results converts to text
+#define GLOBAL_TERMINATION 1         // In real time, the summary actor stops all actors via the framework rather than
+                                     // sending them terminate messages
+#define CHECKPOINT_INTERVAL 0        // In real time, seconds of wall time between checkpoints written to the file
+                                     // "checkpoint" (0 disables checkpoints)
+#define SNAPSHOT_FREQUENCY 0         // Every this many simulated minutes, junction actors stream their vehicle counts
+                                     // to snapshots.<rank> (0 disables snapshots; not in OPTIMISTIC time mode)
+#define PROFILING 0                  // The framework profiles actors and messages to profile.<rank>.json, and prints
+                                     // a summary across all MPI processes
+#define TRACING 0                    // The framework writes the timeline of actors and messages to trace.json, to be
+                                     // opened in a Chrome trace viewer such as chrome://tracing or Perfetto
 
 enum ReadMode {
     NONE = 0,
@@ -59,6 +82,17 @@ enum VehicleType {
     BIKE
 };
 
+// Counters replicated by the framework with REPLICATED_COUNTERS
+enum Counter {
+    ACTIVE_VEHICLES = 0,       // Change in the number of active vehicles since the start of simulation
+    NEW_VEHICLES,              // Number of vehicles added after the start of simulation
+    DELIVERED_PASSENGERS,
+    STRANDED_PASSENGERS,
+    CRASHED_VEHICLES,
+    EXHAUSTED_VEHICLES,
+    NUM_COUNTERS
+};
+
 struct VehicleAttributes {
     int max_speed;
     int max_passengers;
@@ -1,9 +1,13 @@
 #ifndef MAIN_H
 #define MAIN_H
 
+void set_junction_placement(ParallelActorModel &framework, map::RoadMapInfo road_map_info);
+
 void add_junction_actors(ParallelActorModel &framework, int num_junctions, int initial_vehicles,
                          map::RoadMapInfo road_map_info);
 
+void enable_junction_migration(ParallelActorModel &framework, int num_junctions, map::RoadMapInfo road_map_info);
+
 void add_factory_actor(ParallelActorModel &framework, int num_junctions, int initial_vehicles, int max_vehicles,
                        map::RoadMapInfo road_map_info);
 
@@ -11,8 +15,25 @@ void add_summary_actor(ParallelActorModel &framework, int num_junctions, int ini
 
 void add_message_datatype(ParallelActorModel &framework);
 
+void add_statistics_reductions(ParallelActorModel &framework, int num_junctions);
+
+void enable_statistics_counters(ParallelActorModel &framework);
+
+void enable_parallel_results(ParallelActorModel &framework);
+
+void enable_snapshots(ParallelActorModel &framework);
+
+void enable_global_termination(ParallelActorModel &framework);
+
+void enable_checkpoints(ParallelActorModel &framework, const std::string &restore_file);
+
+void enable_profiling(ParallelActorModel &framework);
+
+void enable_tracing(ParallelActorModel &framework);
+
 void print_problem_size(ParallelActorModel &framework, int num_junctions, int num_roads, int initial_vehicles);
 
-void print_execution_time(ParallelActorModel &framework, int log_debug, double start_time, double end_time);
+void print_execution_time(ParallelActorModel &framework, int log_debug, int max_mins, double start_time,
+                          double end_time);
 
 #endif
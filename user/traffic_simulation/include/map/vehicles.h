@@ -0,0 +1,71 @@
+#ifndef VEHICLES_H
+#define VEHICLES_H
+
+#include <vector>
+#include <unordered_map>
+#include "actor/serializer.h"
+#include "payload/vehicle.h"
+
+namespace data {
+
+    /**
+     * Vehicles waiting on a junction or on one of its roads, stored as a structure of arrays.
+     * One of the internal state variables of a junction actor.
+     *
+     * - Vehicle i is described by the i-th element of each array, so that the junction updates its
+     *   vehicles in linear passes over contiguous memory.
+     * - A vehicle is removed by moving the last vehicle into its slot. Removing vehicle i while iterating
+     *   in increasing order thus requires visiting slot i again.
+     */
+    struct Vehicles {
+
+        // Fixed properties
+        std::vector<int> id;
+        std::vector<int> fuel;                           // initial fuel
+        std::vector<int> max_speed;                      // maximum speed of vehicle
+        std::vector<int> passengers;                     // number of passengers on vehicle
+        std::vector<int> source_id;                      // ID of source junction
+        std::vector<int> dest_id;                        // ID of destination junction
+        std::vector<int> start_time;                     // activation time (number of seconds since actors started)
+
+        // State within the junction, not sent to the next junction
+        std::vector<int> speed;                          // current speed
+        std::vector<int> road;                           // index of current road, or -1 if not assigned yet
+        std::vector<char> on_junction;                   // 1 when vehicle is on the junction
+        std::vector<double> remaining_distance;          // Remaining distance to travel
+        std::vector<double> last_distance_check_secs;    // time at last distance check (seconds since actors started)
+
+        std::unordered_map<int, int> slots;              // Index of each vehicle by vehicle ID
+
+        int size() const;
+
+        int add(const payload::Vehicle &vehicle, int road_index);
+
+        payload::Vehicle get(int i) const;
+
+        void remove(int i);
+
+        void remove(int i, std::vector<char> &flags);
+
+        void find_exhausted(int seconds, std::vector<char> &exhausted) const;
+
+        void clear();
+
+        void serialize(actor::Serializer &serializer) const;
+
+        void deserialize(actor::Deserializer &deserializer);
+    };
+
+    /**
+     * Next event of a vehicle on a road, i.e. reaching the end of the road or running out of fuel.
+     * Each road of a junction holds the events of its vehicles in a min-heap, ordered by time and vehicle ID.
+     */
+    struct RoadEvent {
+        double time;
+        int vehicle_id;
+
+        bool operator>(const RoadEvent &other) const;
+    };
+}
+
+#endif
@@ -0,0 +1,37 @@
+#ifndef RESULTS_H
+#define RESULTS_H
+
+#include <map>
+#include <string>
+#include <vector>
+#include "payload/summary.h"
+
+#define RESULTS_MAGIC 0x53455254   // Marks the start of a chunk of the binary results file
+
+namespace payload {
+
+    /**
+     * Header of a chunk of the binary results file. With BINARY_RESULTS, each MPI process writes one chunk
+     * holding the junctions of its junction actors, and chunks follow each other in order of rank.
+     *
+     * The header is followed by the junction table, then the road table, column by column. Each column is an
+     * array of ints:
+     * - Junction table: ID, total vehicles, crashes and number of roads of each junction.
+     * - Road table: source ID, destination ID, total vehicles and peak vehicles of each road. The roads of
+     *   each junction follow each other, in the order of the junction table.
+     */
+    struct ResultsHeader {
+        int magic;             // RESULTS_MAGIC
+        int num_junctions;     // Number of rows of the junction table
+        int num_roads;         // Number of rows of the road table
+    };
+
+    std::string encode_results_record(const JunctionSummary &junction, const std::vector<RoadSummary> &roads);
+
+    std::string encode_results_chunk(const std::map<long, std::string> &records);
+
+    bool decode_results_chunk(const std::string &bytes, long &position, std::vector<JunctionSummary> &junctions,
+                              std::vector<std::vector<RoadSummary>> &roads);
+}
+
+#endif
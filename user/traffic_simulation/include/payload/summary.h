@@ -1,6 +1,9 @@
 #ifndef PAYLOAD_SUMMARY_H
 #define PAYLOAD_SUMMARY_H
 
+#include <string>
+#include <vector>
+
 namespace payload {
 
     /**
@@ -48,6 +51,8 @@ namespace payload {
 
         RoadSummary(int source_id, int dest_id);
     };
+
+    std::string format_detailed_summary(const JunctionSummary &junction, const std::vector<RoadSummary> &roads);
 }
 
 #endif
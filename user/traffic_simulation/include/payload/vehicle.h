@@ -2,40 +2,49 @@
 #define VEHICLE_H
 
 #include <unordered_map>
+#include <vector>
+#include <type_traits>
 #include "constants/constants.h"
 #include "map/load.h"
+#include "util/random.h"
 
 namespace payload {
 
     /**
      * Vehicle object sent between junction actors (corresponds to MPI_VEHICLE).
+     *
+     * - The struct is a plain array of ints, so that it is sent as is, without padding or pointers.
+     * - The state of a vehicle within a junction (i.e. its road, speed and distance) is not sent, since it is
+     *   reset as the vehicle enters the next junction. It is held by the junction (see `data::Vehicles`).
      */
     struct Vehicle {
 
-        // Fixed Properties
         int id;
         int fuel;                            // initial fuel
         int max_speed;                       // maximum speed of vehicle
         int passengers;                      // number of passengers on vehicle
         int source_id;                       // ID of source junction
         int dest_id;                         // ID of destination junction
-        int start_time;                      // activation time (number of seconds since Unix epoch)
+        int start_time;                      // activation time (number of seconds since actors started)
 
-        // Variable Properties
-        int speed;                           // current speed
-        int last_distance_check_secs;        // time at last distance check (number of seconds since Unix epoch)
-        bool on_junction;                    // True when vehicle is on a junction
-        data::Road *current_road;           // current road vehicle is on
-        double remaining_distance;           // Remaining distance to travel
-
-        Vehicle();
+        Vehicle() = default;
 
         Vehicle(int id, int fuel, int max_speed, int passengers, int source_id, int dest_id);
 
-        Vehicle(int id, VehicleType type, map::RoadMapInfo &road_map_info);
+        Vehicle(int id, VehicleType type, map::RoadMapInfo &road_map_info, RandomGenerator &generator);
     };
 
-    typedef std::unordered_map<int, Vehicle> Vehicles;
+    // Number of ints in a vehicle object, as described by MPI_VEHICLE
+    const int VEHICLE_NUM_INTEGERS = 7;
+
+    static_assert(std::is_trivial<Vehicle>::value && std::is_standard_layout<Vehicle>::value,
+                  "payload::Vehicle must be a POD to be sent as is");
+    static_assert(sizeof(Vehicle) == VEHICLE_NUM_INTEGERS * sizeof(int),
+                  "payload::Vehicle must match MPI_VEHICLE without padding");
+
+    void encode_vehicles(const void *data, int count, std::vector<char> &bytes);
+
+    void decode_vehicles(const char *bytes, int size, void *data, int count);
 }
 
 #endif
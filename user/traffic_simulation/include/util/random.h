@@ -1,8 +1,15 @@
 #ifndef RANDOM_H
 #define RANDOM_H
 
+#include <random>
+
+// Random number generator of an actor, trivially copyable, so that it is serialized with the actor
+typedef std::minstd_rand RandomGenerator;
+
 void set_random_seed(int seed);
 
 int get_random_integer(int from, int to);
 
+int get_random_integer(RandomGenerator &generator, int from, int to);
+
 #endif
@@ -7,19 +7,17 @@
 class Timer {
 public:
 
-    int start_seconds;                        // The Unix time at which this object was created
+    int start_seconds;                        // The time at which the simulation started, in seconds
     int simulation_minutes;                   // The elapsed simulation minutes
     int real_seconds_to_simulation_minutes;   // The ratio of real seconds to simulation minutes
 
     Timer();
 
-    explicit Timer(int real_seconds_to_simulation_minutes);
+    Timer(int real_seconds_to_simulation_minutes, int start_seconds);
 
-    bool update_simulation_minutes();
+    bool update_simulation_minutes(int current_seconds);
 
-    int get_simulation_minutes() const;
-
-    static int get_current_seconds();
+    int get_simulation_minutes(int current_seconds) const;
 
     static long get_elapsed_in_microseconds(struct timeval &start, struct timeval &end);
 };
@@ -0,0 +1,32 @@
+#!/bin/sh
+# Check that synchronization by null messages simulates the tiny problem exactly as bulk-synchronous
+# execution does: both must print the same final summary and write the same results.
+# LAUNCHER starts the MPI processes, e.g. "mpiexec -n 4" or "srun".
+
+LAUNCHER=${LAUNCHER:-"mpiexec -n 4"}
+ARGS=${ARGS:-"data/tiny_problem 30 30 150 5 1 0 2"}
+exe=build/traffic_simulation_program
+out=$(mktemp -d)
+
+for mode in BSP NULL_MESSAGES; do
+    make -s local-build DEFINES=-DTIME_MODE=actor::${mode} > /dev/null || exit 1
+    ${LAUNCHER} ${exe} ${ARGS} | grep "^Finished" > ${out}/summary.${mode} || exit 1
+    cp results ${out}/results.${mode}
+done
+
+# Restore the build with the configured time mode
+make -s local-build > /dev/null
+
+status=0
+for file in summary results; do
+    if ! diff ${out}/${file}.BSP ${out}/${file}.NULL_MESSAGES; then
+        echo "NULL_MESSAGES ${file} differs from BSP"
+        status=1
+    fi
+done
+
+if [ ${status} -eq 0 ]; then
+    echo "NULL_MESSAGES matches BSP: $(cat ${out}/summary.BSP)"
+fi
+rm -rf ${out}
+exit ${status}
@@ -18,14 +18,30 @@ actor::Factory::Factory(actor::id id, int summary_id, int initial_number_vehicle
         max_vehicles(max_vehicles),
         road_map_info(road_map_info),
         current_number_vehicles(0),
-        total_number_vehicles(0) {}
+        total_number_vehicles(0),
+        generator(RANDOM_SEED + id) {}
 
 /**
  * Initialize factory actor.
  */
 bool actor::Factory::pre_barrier_init() {
 
-    // Load road map from file
+    if (!load_road_map()) {
+        return false;
+    }
+
+    // Initialize vehicle statistics
+    current_number_vehicles = initial_number_vehicles;
+    total_number_vehicles = initial_number_vehicles;
+
+    return true;
+}
+
+/**
+ * Load road map from file, along with its connected components.
+ */
+bool actor::Factory::load_road_map() {
+
     auto success = map::load(road_map_info, road_map);
     if (!success) {
         fprintf(stderr, "failed to load %s\n", road_map_info.filename.c_str());
@@ -44,10 +60,6 @@ bool actor::Factory::pre_barrier_init() {
     // Create connected components
     components = disjoint_set.get_connected_components();
 
-    // Initialize vehicle statistics
-    current_number_vehicles = initial_number_vehicles;
-    total_number_vehicles = initial_number_vehicles;
-
     return true;
 }
 
@@ -55,7 +67,7 @@ bool actor::Factory::pre_barrier_init() {
  * Initialize `timer`.
  */
 bool actor::Factory::post_barrier_init() {
-    timer = Timer(MIN_LENGTH_SECONDS);
+    timer = Timer(MIN_LENGTH_SECONDS, 0);
     return true;
 }
 
@@ -65,6 +77,7 @@ bool actor::Factory::post_barrier_init() {
  *     - This value signifies the number of vehicles that have exited the simulation.
  * (2) MPI_TERMINATE
  *     - Terminate this actor
+ * In logical time, both take effect at the time the message is stamped with (see `run`).
  */
 actor::next_step actor::Factory::ingress(mail::Message &message) {
 
@@ -74,10 +87,18 @@ actor::next_step actor::Factory::ingress(mail::Message &message) {
         // This integer indicates the number of vehicles that have been removed from simulation.
         // Update current number of vehicles in simulation.
         auto number_vehicles = (int *) message.data;
-        current_number_vehicles -= *number_vehicles;
+        if (clock.mode != actor::REAL_TIME) {
+            exiting_vehicles.emplace(message.timestamp, *number_vehicles);
+        } else {
+            current_number_vehicles -= *number_vehicles;
+        }
         return actor::CONTINUE;
 
     } else if (message.mpi_datatype == MPI_TERMINATE) {
+        if (clock.mode != actor::REAL_TIME) {
+            terminate_time = std::min(terminate_time, message.timestamp);
+            return actor::CONTINUE;
+        }
         return actor::STOP;
     } else {
         fprintf(stderr, "unexpected mpi datatype at ingress\n");
@@ -90,32 +111,135 @@ actor::next_step actor::Factory::ingress(mail::Message &message) {
  * and send them to their designated source junction actors. Ensure the number of new vehicles
  * generated adheres to the maximum limit for active vehicles. Lastly, send the number new
  * vehicles to the summary actor.
+ *
+ * In logical time, every simulated minute up to the time allowed by the framework, or up to the end of
+ * simulation, is processed in turn, after removing the vehicles that exited the simulation up to that minute.
  */
 actor::next_step actor::Factory::run() {
 
-    if (timer.update_simulation_minutes()) {
+    if (clock.mode != actor::REAL_TIME) {
+        auto end_time = std::min(clock.safe_time, terminate_time);
+        for (auto t = next_event_time(); t < end_time; t = next_event_time()) {
+            timer.update_simulation_minutes(static_cast<int>(t));
+            while (!exiting_vehicles.empty() && exiting_vehicles.begin()->first <= t) {
+                current_number_vehicles -= exiting_vehicles.begin()->second;
+                exiting_vehicles.erase(exiting_vehicles.begin());
+            }
+            add_vehicles(t + MIN_TRAVEL_SECONDS);
+        }
+        return terminate_time < clock.safe_time ? actor::STOP : actor::CONTINUE;
+    }
 
-        if (current_number_vehicles < max_vehicles) {
+    if (timer.update_simulation_minutes(static_cast<int>(clock.wall_time / NANOSECONDS_PER_SECOND))) {
+        add_vehicles(0);
+    }
 
-            // Determine number of new vehicles
-            int num_new_vehicles = get_random_integer(MIN_NEW_VEHICLES, MAX_NEW_VEHICLES + 1);
-            num_new_vehicles = std::min(num_new_vehicles, max_vehicles - current_number_vehicles);
+    return actor::CONTINUE;
+}
 
-            // Generate new vehicles
-            auto vehicles_by_junction = std::unordered_map<int, std::vector<payload::Vehicle>>();
-            generate_vehicles(vehicles_by_junction, num_new_vehicles);
+/**
+ * In logical time, returns the start of the next simulated minute, or the end of simulation if earlier.
+ */
+double actor::Factory::next_event_time() {
+    return std::min(terminate_time, static_cast<double>((timer.simulation_minutes + 1) * MIN_LENGTH_SECONDS));
+}
 
-            // Send vehicles to junction actors and statistics to summary actor.
-            send_vehicles(vehicles_by_junction);
-            send_statistics_to_summary(num_new_vehicles);
+/**
+ * In logical time, new vehicles and statistics are stamped MIN_TRAVEL_SECONDS after the simulated minute starts.
+ */
+double actor::Factory::lookahead() {
+    return MIN_TRAVEL_SECONDS;
+}
 
-            // Update vehicle statistics
-            current_number_vehicles += num_new_vehicles;
-            total_number_vehicles += num_new_vehicles;
-        }
+/**
+ * New vehicles are sent to any junction, and statistics to the summary actor.
+ */
+std::vector<actor::id> actor::Factory::channels() {
+
+    std::vector<actor::id> ids;
+    for (int i = 0; i < road_map.size(); i++) {
+        ids.push_back(i);
     }
+    ids.push_back(summary_id);
 
-    return actor::CONTINUE;
+    return ids;
+}
+
+/**
+ * Write the state of the factory actor to a checkpoint. The factory actor does not support serialization
+ * otherwise, so that it is not rolled back in optimistic execution. The road map is not written, since it
+ * is loaded from file on restore.
+ */
+bool actor::Factory::checkpoint(actor::Serializer &serializer) {
+
+    serializer.write(summary_id);
+    serializer.write(initial_number_vehicles);
+    serializer.write(max_vehicles);
+    serializer.write(road_map_info.filename);
+    serializer.write(road_map_info.road_length_scale_down);
+    serializer.write(road_map_info.road_length_minimum);
+    serializer.write(road_map_info.fuel_scale_up);
+
+    serializer.write(current_number_vehicles);
+    serializer.write(total_number_vehicles);
+    serializer.write(timer);
+    serializer.write(generator);
+
+    return true;
+}
+
+/**
+ * Restore the state of the factory actor from a checkpoint.
+ */
+bool actor::Factory::restore(actor::Deserializer &deserializer) {
+
+    deserializer.read(summary_id);
+    deserializer.read(initial_number_vehicles);
+    deserializer.read(max_vehicles);
+    deserializer.read(road_map_info.filename);
+    deserializer.read(road_map_info.road_length_scale_down);
+    deserializer.read(road_map_info.road_length_minimum);
+    deserializer.read(road_map_info.fuel_scale_up);
+
+    deserializer.read(current_number_vehicles);
+    deserializer.read(total_number_vehicles);
+    deserializer.read(timer);
+    deserializer.read(generator);
+
+    return load_road_map();
+}
+
+/**
+ * Create new vehicles for the current simulated minute and send them, stamped with the given timestamp.
+ */
+void actor::Factory::add_vehicles(double timestamp) {
+
+    // In real time, the number of active vehicles may be read from the replicated counters
+    if (counters != nullptr) {
+        current_number_vehicles = initial_number_vehicles + static_cast<int>(counters->get(ACTIVE_VEHICLES));
+    }
+
+    if (current_number_vehicles < max_vehicles) {
+
+        // Determine number of new vehicles
+        int num_new_vehicles = get_random_integer(generator, MIN_NEW_VEHICLES, MAX_NEW_VEHICLES + 1);
+        num_new_vehicles = std::min(num_new_vehicles, max_vehicles - current_number_vehicles);
+
+        // Generate new vehicles
+        auto vehicles_by_junction = std::unordered_map<int, std::vector<payload::Vehicle>>();
+        generate_vehicles(vehicles_by_junction, num_new_vehicles);
+
+        // Send vehicles to junction actors and statistics to summary actor.
+        send_vehicles(vehicles_by_junction, timestamp);
+        send_statistics_to_summary(num_new_vehicles, timestamp);
+
+        // Update vehicle statistics
+        current_number_vehicles += num_new_vehicles;
+        total_number_vehicles += num_new_vehicles;
+        if (counters != nullptr) {
+            counters->add(ACTIVE_VEHICLES, num_new_vehicles);
+        }
+    }
 }
 
 /**
@@ -130,8 +254,8 @@ void actor::Factory::generate_vehicles(std::unordered_map<int, std::vector<paylo
     auto max_id = total_number_vehicles + number_vehicles;
 
     while (vehicle_id < max_id) {
-        auto vehicle_type = static_cast<VehicleType>(get_random_integer(0, num_vehicle_types));
-        auto vehicle = payload::Vehicle(vehicle_id, vehicle_type, road_map_info);
+        auto vehicle_type = static_cast<VehicleType>(get_random_integer(generator, 0, num_vehicle_types));
+        auto vehicle = payload::Vehicle(vehicle_id, vehicle_type, road_map_info, generator);
         assign_source_and_destination(vehicle.source_id, vehicle.dest_id);
         vehicles_by_junction[vehicle.source_id].push_back(vehicle);
         vehicle_id++;
@@ -153,7 +277,7 @@ int actor::Factory::generate_random_destination(int source) {
 
     auto root = disjoint_set.find(source);
     auto component_size = static_cast<int>(components[root].size());
-    auto i = get_random_integer(0, component_size);
+    auto i = get_random_integer(generator, 0, component_size);
     return components[root][i];
 }
 
@@ -166,7 +290,7 @@ void actor::Factory::assign_source_and_destination(int &source, int &dest) {
     auto num_junctions = static_cast<int>(road_map.size());
     while (true) {
 
-        source = get_random_integer(0, num_junctions);
+        source = get_random_integer(generator, 0, num_junctions);
         dest = generate_random_destination(source);
         if (source == dest) {
             // When source and dest refer to the same junction, generate a new pair of junctions.
@@ -186,7 +310,8 @@ void actor::Factory::assign_source_and_destination(int &source, int &dest) {
 /**
  * Send new vehicles to their corresponding junctions.
  */
-void actor::Factory::send_vehicles(std::unordered_map<int, std::vector<payload::Vehicle>> &vehicles_by_junction) {
+void actor::Factory::send_vehicles(std::unordered_map<int, std::vector<payload::Vehicle>> &vehicles_by_junction,
+                                   double timestamp) {
 
     for (const auto &kv: vehicles_by_junction) {
 
@@ -195,6 +320,7 @@ void actor::Factory::send_vehicles(std::unordered_map<int, std::vector<payload::
         message.count = static_cast<int>(vehicles_by_junction[i].size());
         message.data = vehicles_by_junction[i].data();
         message.mpi_datatype = MPI_VEHICLE;
+        message.timestamp = timestamp;
 
         if (message.count != 0) {
             mailbox.send(message, i);
@@ -205,7 +331,13 @@ void actor::Factory::send_vehicles(std::unordered_map<int, std::vector<payload::
 /**
  * Send the number of new vehicles to the summary actor.
  */
-void actor::Factory::send_statistics_to_summary(int number_vehicles) {
+void actor::Factory::send_statistics_to_summary(int number_vehicles, double timestamp) {
+
+    // In real time, the summary actor may read the replicated counters instead
+    if (counters != nullptr) {
+        counters->add(NEW_VEHICLES, number_vehicles);
+        return;
+    }
 
     if (number_vehicles != 0) {
         auto summary = payload::PeriodicSummary(0, 0, 0, 0, number_vehicles);
@@ -213,6 +345,7 @@ void actor::Factory::send_statistics_to_summary(int number_vehicles) {
         message.data = &summary;
         message.count = 1;
         message.mpi_datatype = MPI_PERIODIC_SUMMARY;
-        mailbox.send(message, summary_id);
+        message.timestamp = timestamp;
+        mailbox.reduce(message, summary_id);
     }
 }
@@ -2,11 +2,15 @@
 #include <cstring>
 #include <cassert>
 #include <vector>
+#include <algorithm>
+#include <functional>
 #include "map/load.h"
+#include "map/vehicles.h"
 #include "actors/junction_and_roads.h"
 #include "mail/message.h"
 #include "payload/datatype.h"
 #include "payload/summary.h"
+#include "payload/results.h"
 #include "map/search.h"
 #include "util/random.h"
 #include "util/disjoint_set.h"
@@ -20,7 +24,7 @@ actor::JunctionAndRoads::JunctionAndRoads(actor::id id,
                                           map::RoadMapInfo &road_map_info) :
         Actor(id), factory_id(factory_id), summary_id(summary_id),
         initial_vehicle_id(initial_vehicle_id), initial_vehicle_size(initial_vehicle_size),
-        road_map_info(road_map_info) {}
+        road_map_info(road_map_info), generator(RANDOM_SEED + id) {}
 
 bool actor::JunctionAndRoads::pre_barrier_init() {
 
@@ -39,14 +43,15 @@ bool actor::JunctionAndRoads::pre_barrier_init() {
     }
 
     junction = data::Junction(node.id, node.has_traffic_lights);
-    junction.current_number_vehicles = static_cast<int>(vehicles.size());
-    junction.summary.total_number_vehicles = static_cast<int>(vehicles.size());
+    junction.current_number_vehicles = vehicles.size();
+    junction.summary.total_number_vehicles = vehicles.size();
 
     // Initialize roads for this junction
     for (int edge_id = 0; edge_id < node.roads.size(); edge_id++) {
         auto edge = node.roads[edge_id];
         roads.emplace_back(edge_id, id, edge.dest->id, edge.road_length, edge.max_speed);
     }
+    road_events.resize(roads.size());
 
     // Initialize vehicles starting from this junction
     if (initial_vehicle_size > 0 && !node.roads.empty()) {
@@ -65,15 +70,13 @@ bool actor::JunctionAndRoads::pre_barrier_init() {
         auto vehicle_id_end = initial_vehicle_id + initial_vehicle_size - 1;
         for (int vehicle_id = initial_vehicle_id; vehicle_id <= vehicle_id_end; vehicle_id++) {
 
-            auto vehicle_type = static_cast<VehicleType>(get_random_integer(0, num_vehicle_types));
-            auto vehicle = payload::Vehicle(vehicle_id, vehicle_type, road_map_info);
+            auto vehicle_type = static_cast<VehicleType>(get_random_integer(generator, 0, num_vehicle_types));
+            auto vehicle = payload::Vehicle(vehicle_id, vehicle_type, road_map_info, generator);
             vehicle.source_id = junction.id;
             vehicle.dest_id = generate_vehicle_destination(vehicle.source_id, disjoint_set, components);
-            vehicle.on_junction = true;
-            vehicle.current_road = NULL;
             vehicle.start_time = 0;
 
-            vehicles[vehicle.id] = vehicle;
+            vehicles.add(vehicle, -1);
             junction.current_number_vehicles++;
         }
 
@@ -87,12 +90,15 @@ bool actor::JunctionAndRoads::pre_barrier_init() {
 
 bool actor::JunctionAndRoads::post_barrier_init() {
 
-    timer = Timer(MIN_LENGTH_SECONDS);
+    // The simulation starts at time 0
+    timer = Timer(MIN_LENGTH_SECONDS, 0);
+    update_current_time();
+    if (clock.mode != actor::REAL_TIME) {
+        return true;
+    }
 
-    auto current_seconds = Timer::get_current_seconds();
-    for (const auto &kv: vehicles) {
-        auto id = kv.first;
-        vehicles[id].start_time = current_seconds;
+    for (int i = 0; i < vehicles.size(); i++) {
+        vehicles.start_time[i] = current_seconds;
     }
 
     return true;
@@ -104,72 +110,241 @@ actor::next_step actor::JunctionAndRoads::ingress(mail::Message &message) {
         process_vehicles(message);
         return actor::CONTINUE;
     } else if (message.mpi_datatype == MPI_TERMINATE) {
-        send_final_summaries();
-        return actor::STOP;
+        // In logical time, the simulation ends at the time the terminate message is stamped with
+        if (clock.mode != actor::REAL_TIME) {
+            terminate_time = std::min(terminate_time, message.timestamp);
+            return actor::CONTINUE;
+        }
+        return terminate();
     } else {
         fprintf(stderr, "received unexpected message type");
         return actor::STOP;
     }
 }
 
+/**
+ * At the end of simulation, i.e. on the terminate message or the global stop, hand over the detailed summaries
+ * and stop.
+ */
+actor::next_step actor::JunctionAndRoads::terminate() {
+
+    if (output != nullptr) {
+        write_final_summaries();
+    } else {
+        send_final_summaries();
+    }
+    return actor::STOP;
+}
+
 actor::next_step actor::JunctionAndRoads::run() {
 
+    // In logical time, process events up to the time allowed by the framework, or up to the end of simulation,
+    // sending the statistics of each event stamped with its time
+    if (clock.mode != actor::REAL_TIME) {
+        auto end_time = std::min(clock.safe_time, terminate_time);
+        for (auto t = next_event_time(); t < end_time; t = next_event_time()) {
+            process_events(static_cast<int>(t));
+            send_statistics(periodic_summary);
+            periodic_summary = payload::PeriodicSummary();
+        }
+        write_snapshot();
+        if (terminate_time < clock.safe_time) {
+            current_seconds = static_cast<int>(terminate_time);
+            return terminate();
+        }
+        return actor::CONTINUE;
+    }
+
+    update_current_time();
+
     // If junction has traffic lights, switch enabled road every simulated minute.
     switch_enabled_road_at_traffic_light();
 
-    // Move vehicles
-    std::vector<int> vehicles_to_be_removed;
-    for (const auto &kv: vehicles) {
-        auto i = kv.first;
+    // Move vehicles from the junction onto roads, and off roads they reached the end of
+    process_waiting_vehicles();
+    process_road_events(current_time);
 
-        // If vehicle exhausts fuel, remove it from simulation.
-        if (Timer::get_current_seconds() - vehicles[i].start_time > vehicles[i].fuel) {
-            remove_vehicle_due_to_fuel_exhaustion(i);
-            vehicles_to_be_removed.push_back(i);
-            continue;
+    send_statistics(periodic_summary);
+    periodic_summary = payload::PeriodicSummary();
+    write_snapshot();
+
+    return actor::CONTINUE;
+}
+
+/**
+ * In logical time, returns the earliest time at which a vehicle arrives at the junction, runs out of fuel,
+ * may exit the junction or reaches the end of its road, or at which the simulation ends. Vehicles waiting at a
+ * red traffic light are considered again at the next simulated minute. Only the earliest event of each road is
+ * considered.
+ */
+double actor::JunctionAndRoads::next_event_time() {
+
+    double next_time = terminate_time;
+    if (!arriving_vehicles.empty()) {
+        next_time = std::min(next_time, static_cast<double>(arriving_vehicles.begin()->first));
+    }
+
+    for (const auto &events: road_events) {
+        if (!events.empty()) {
+            next_time = std::min(next_time, events.front().time);
         }
+    }
 
-        if (vehicles[i].on_junction) {
+    auto next_minute_seconds = (timer.get_simulation_minutes(current_seconds) + 1) * MIN_LENGTH_SECONDS;
+    for (int i = 0; i < vehicles.size(); i++) {
+        double vehicle_time = vehicles.start_time[i] + vehicles.fuel[i] + 1;
+        if (vehicles.road[i] == -1 || !junction.has_traffic_lights
+            || vehicles.road[i] == junction.road_enabled_at_traffic_lights) {
+            vehicle_time = current_seconds;
+        } else {
+            vehicle_time = std::min(vehicle_time, static_cast<double>(next_minute_seconds));
+        }
+        next_time = std::min(next_time, vehicle_time);
+    }
 
-            if (vehicles[i].current_road == NULL) {
-                assign_road_to_vehicle(i);
-            }
+    return next_time;
+}
 
-            if (junction.has_traffic_lights) {
-                auto success = vehicle_exits_junction_with_traffic_lights(i);
-                if (!success) {
-                    continue;
-                }
-            } else {
-                auto success = vehicle_exits_junction_without_traffic_lights(i);
-                if (!success) {
-                    vehicles_to_be_removed.push_back(i);
-                    continue;
-                }
-            }
+/**
+ * In logical time, vehicles are sent to the next junction as they enter a road and statistics are sent
+ * with a delay, so that no message is sent less than MIN_TRAVEL_SECONDS ahead of the time it is sent at.
+ */
+double actor::JunctionAndRoads::lookahead() {
+    return MIN_TRAVEL_SECONDS;
+}
+
+/**
+ * Vehicles are sent to the destination junctions of the outgoing roads, and statistics to the factory
+ * and summary actors.
+ */
+std::vector<actor::id> actor::JunctionAndRoads::channels() {
 
-            vehicle_enters_road(i);
+    std::vector<actor::id> ids = {factory_id, summary_id};
+    for (const auto &road: roads) {
+        if (std::find(ids.begin(), ids.end(), road.dest_id) == ids.end()) {
+            ids.push_back(road.dest_id);
         }
+    }
 
-        assert(vehicles[i].on_junction == false);
-        assert(vehicles[i].current_road != NULL);
+    return ids;
+}
 
-        move_vehicle_along_road(i);
-        if (vehicles[i].remaining_distance <= 0) {
-            vehicle_exits_road(i);
-            vehicles_to_be_removed.push_back(i);
-            continue;
+/**
+ * A vehicle is sent to the next junction when it enters the road, stamped with its time of arrival.
+ * The minimum travel time on a road is its length at the highest speed vehicles may drive on it.
+ */
+double actor::JunctionAndRoads::channel_lookahead(actor::id to) {
+
+    double lookahead = NO_EVENT;
+    for (const auto &road: roads) {
+        if (road.dest_id == to) {
+            auto max_speed = std::max(10, road.max_speed);
+            auto travel_seconds = (road.road_length + max_speed - 1) / max_speed;
+            lookahead = std::min(lookahead, static_cast<double>(std::max(MIN_TRAVEL_SECONDS, travel_seconds)));
         }
     }
 
-    for (const auto &i: vehicles_to_be_removed) {
-        vehicles.erase(i);
+    return lookahead == NO_EVENT ? this->lookahead() : lookahead;
+}
+
+/**
+ * Write the state of the junction actor, so that it can migrate to another MPI process or be rolled back
+ * in optimistic execution. The road map is not written, since the receiving MPI process loads it from file.
+ */
+bool actor::JunctionAndRoads::serialize(actor::Serializer &serializer) {
+
+    serializer.write(factory_id);
+    serializer.write(summary_id);
+    serializer.write(initial_vehicle_id);
+    serializer.write(initial_vehicle_size);
+    serializer.write(road_map_info.filename);
+    serializer.write(road_map_info.road_length_scale_down);
+    serializer.write(road_map_info.road_length_minimum);
+    serializer.write(road_map_info.fuel_scale_up);
+
+    serializer.write(junction);
+    serializer.write(roads);
+    serializer.write(periodic_summary);
+    serializer.write(timer);
+
+    vehicles.serialize(serializer);
+    road_vehicles.serialize(serializer);
+    serializer.write(static_cast<int>(road_events.size()));
+    for (const auto &events: road_events) {
+        serializer.write(events);
     }
 
-    send_statistics(periodic_summary);
-    periodic_summary = payload::PeriodicSummary();
+    // Vehicles arriving in logical time
+    std::vector<int> arrival_times;
+    std::vector<payload::Vehicle> arrival_list;
+    for (const auto &kv: arriving_vehicles) {
+        arrival_times.push_back(kv.first);
+        arrival_list.push_back(kv.second);
+    }
+    serializer.write(current_seconds);
+    serializer.write(current_time);
+    serializer.write(next_snapshot_minutes);
+    serializer.write(generator);
+    serializer.write(arrival_times);
+    serializer.write(arrival_list);
+    serializer.write(terminate_time);
 
-    return actor::CONTINUE;
+    return true;
+}
+
+/**
+ * Restore the state of a junction actor that migrated to current MPI process, or that is rolled back.
+ */
+bool actor::JunctionAndRoads::deserialize(actor::Deserializer &deserializer) {
+
+    deserializer.read(factory_id);
+    deserializer.read(summary_id);
+    deserializer.read(initial_vehicle_id);
+    deserializer.read(initial_vehicle_size);
+    deserializer.read(road_map_info.filename);
+    deserializer.read(road_map_info.road_length_scale_down);
+    deserializer.read(road_map_info.road_length_minimum);
+    deserializer.read(road_map_info.fuel_scale_up);
+
+    deserializer.read(junction);
+    deserializer.read(roads);
+    deserializer.read(periodic_summary);
+    deserializer.read(timer);
+
+    vehicles.deserialize(deserializer);
+    road_vehicles.deserialize(deserializer);
+    int num_roads;
+    deserializer.read(num_roads);
+    road_events.resize(num_roads);
+    for (auto &events: road_events) {
+        deserializer.read(events);
+    }
+
+    std::vector<int> arrival_times;
+    std::vector<payload::Vehicle> arrival_list;
+    deserializer.read(current_seconds);
+    deserializer.read(current_time);
+    deserializer.read(next_snapshot_minutes);
+    deserializer.read(generator);
+    deserializer.read(arrival_times);
+    deserializer.read(arrival_list);
+    deserializer.read(terminate_time);
+    arriving_vehicles.clear();
+    for (int i = 0; i < arrival_list.size(); i++) {
+        arriving_vehicles.emplace(arrival_times[i], arrival_list[i]);
+    }
+
+    // Load road map from file, unless the actor already has it
+    if (!road_map.empty()) {
+        return true;
+    }
+    auto success = map::load(road_map_info, road_map);
+    if (!success) {
+        fprintf(stderr, "failed to load %s\n", road_map_info.filename.c_str());
+        return false;
+    }
+
+    return true;
 }
 
 /**
@@ -191,7 +366,7 @@ int actor::JunctionAndRoads::generate_vehicle_destination(int source, DisjointSe
     auto component_size = static_cast<int>(components[root].size());
     while (true) {
 
-        auto i = get_random_integer(0, component_size);
+        auto i = get_random_integer(generator, 0, component_size);
         dest = components[root][i];
         if (source == dest) {
             // When source and dest refer to the same junction, generate a new pair of junctions.
@@ -219,28 +394,149 @@ void actor::JunctionAndRoads::process_vehicles(mail::Message &message) {
     auto count = message.count;
     auto *data = (payload::Vehicle *) message.data;
 
+    // In logical time, vehicles arrive at the time the message is stamped with
+    if (clock.mode == actor::REAL_TIME) {
+        update_current_time();
+    }
+
     payload::Vehicle vehicle{};
     for (int i = 0; i < count; i++) {
 
         // Copy vehicle data
         std::memcpy(&vehicle, &data[i], sizeof(payload::Vehicle));
 
-        if (vehicle.dest_id == junction.id) {
-            // Current junction is the vehicle's destination
-            periodic_summary.delivered_passengers += vehicle.passengers;
-            send_statistics_to_factory(1);
+        if (clock.mode == actor::REAL_TIME) {
+            receive_vehicle(vehicle);
         } else {
-            // Add vehicle to list of vehicles waiting in current junction
-            vehicle.on_junction = true;
-            vehicle.current_road = NULL;
-            vehicle.start_time = vehicle.start_time <= 0 ? Timer::get_current_seconds() : vehicle.start_time;
-            vehicles[vehicle.id] = vehicle;
-            junction.current_number_vehicles++;
+            arriving_vehicles.emplace(static_cast<int>(message.timestamp), vehicle);
         }
     }
+}
+
+/**
+ * Add a vehicle arriving at the current junction to the list of vehicles waiting in current junction.
+ * If current junction is the vehicle's destination, remove it from simulation and notify factory actor.
+ */
+void actor::JunctionAndRoads::receive_vehicle(payload::Vehicle &vehicle) {
 
     // Keep track of total number vehicles that visited the current junction
-    junction.summary.total_number_vehicles += count;
+    junction.summary.total_number_vehicles++;
+
+    if (vehicle.dest_id == junction.id) {
+        // Current junction is the vehicle's destination
+        periodic_summary.delivered_passengers += vehicle.passengers;
+        send_statistics_to_factory(1);
+    } else {
+        // Add vehicle to list of vehicles waiting in current junction
+        vehicle.start_time = vehicle.start_time < 0 ? current_seconds : vehicle.start_time;
+        vehicles.add(vehicle, -1);
+        junction.current_number_vehicles++;
+    }
+}
+
+/**
+ * In logical time, process the events of the junction at the given time in seconds:
+ *
+ * (1) Vehicles arriving at this time join the junction.
+ * (2) The traffic lights enable the road of the current simulated minute.
+ * (3) Vehicles waiting on the junction that run out of fuel are removed from simulation, the others may exit
+ *     the junction and enter their road (see `process_waiting_vehicles` method).
+ * (4) Vehicles on roads whose next event is due run out of fuel or leave their road.
+ */
+void actor::JunctionAndRoads::process_events(int seconds) {
+
+    current_seconds = seconds;
+    current_time = seconds;
+
+    while (!arriving_vehicles.empty() && arriving_vehicles.begin()->first <= current_seconds) {
+        receive_vehicle(arriving_vehicles.begin()->second);
+        arriving_vehicles.erase(arriving_vehicles.begin());
+    }
+
+    if (junction.has_traffic_lights && !roads.empty()) {
+        auto number_of_roads = static_cast<int>(roads.size());
+        junction.road_enabled_at_traffic_lights = timer.get_simulation_minutes(current_seconds) % number_of_roads;
+    }
+
+    process_waiting_vehicles();
+    process_road_events(current_seconds);
+}
+
+/**
+ * Let the vehicles waiting on the junction exit it, unless they run out of fuel, crash or wait at a red
+ * traffic light. Vehicles that exit the junction enter their road. In logical time, since their time of arrival
+ * at the next junction is known, they are sent right away, stamped with that time, unless they run out of fuel
+ * on the road.
+ */
+void actor::JunctionAndRoads::process_waiting_vehicles() {
+
+    // The fuel of all waiting vehicles is checked in one pass, and the flags follow the vehicles as they are removed
+    vehicles.find_exhausted(current_seconds, exhausted);
+
+    for (int i = 0; i < vehicles.size();) {
+
+        // If vehicle exhausts fuel, remove it from simulation.
+        if (exhausted[i]) {
+            remove_vehicle_due_to_fuel_exhaustion(vehicles, i);
+            vehicles.remove(i, exhausted);
+            continue;
+        }
+
+        if (vehicles.road[i] == -1) {
+            assign_road_to_vehicle(i);
+        }
+
+        if (junction.has_traffic_lights) {
+            auto success = vehicle_exits_junction_with_traffic_lights(i);
+            if (!success) {
+                i++;
+                continue;
+            }
+        } else {
+            auto success = vehicle_exits_junction_without_traffic_lights(i);
+            if (!success) {
+                vehicles.remove(i, exhausted);
+                continue;
+            }
+        }
+
+        auto j = vehicle_enters_road(i);
+        vehicles.remove(i, exhausted);
+
+        if (clock.mode != actor::REAL_TIME) {
+            auto arrival_seconds = static_cast<int>(arrival_time(j));
+            if (arrival_seconds - road_vehicles.start_time[j] <= road_vehicles.fuel[j]) {
+                send_vehicle_to_next_junction(j, arrival_seconds);
+            }
+        }
+    }
+}
+
+/**
+ * Process the vehicles on roads whose next event is due by the given time. Vehicles that run out of fuel are
+ * removed from simulation, and vehicles that reach the end of their road leave it. In real time, they are sent
+ * to the next junction as they leave the road.
+ */
+void actor::JunctionAndRoads::process_road_events(double time) {
+
+    for (auto &events: road_events) {
+        while (!events.empty() && events.front().time <= time) {
+
+            std::pop_heap(events.begin(), events.end(), std::greater<data::RoadEvent>());
+            auto i = road_vehicles.slots.at(events.back().vehicle_id);
+            events.pop_back();
+
+            if (current_seconds - road_vehicles.start_time[i] > road_vehicles.fuel[i]) {
+                remove_vehicle_due_to_fuel_exhaustion(road_vehicles, i);
+            } else {
+                if (clock.mode == actor::REAL_TIME) {
+                    send_vehicle_to_next_junction(i, current_seconds);
+                }
+                vehicle_exits_road(i);
+            }
+            road_vehicles.remove(i);
+        }
+    }
 }
 
 /**
@@ -248,7 +544,7 @@ void actor::JunctionAndRoads::process_vehicles(mail::Message &message) {
  */
 void actor::JunctionAndRoads::switch_enabled_road_at_traffic_light() {
 
-    if (timer.update_simulation_minutes()) {
+    if (timer.update_simulation_minutes(current_seconds)) {
         if (junction.has_traffic_lights && !roads.empty()) {
             auto current_road = junction.road_enabled_at_traffic_lights;
             auto number_of_roads = static_cast<int>(roads.size());
@@ -258,19 +554,21 @@ void actor::JunctionAndRoads::switch_enabled_road_at_traffic_light() {
 }
 
 /**
- * Remove vehicle from simulation due to empty fuel tank.
+ * Remove vehicle i of the given vehicles, i.e. waiting on the junction or on a road, from simulation due to
+ * empty fuel tank.
  */
-void actor::JunctionAndRoads::remove_vehicle_due_to_fuel_exhaustion(int i) {
+void actor::JunctionAndRoads::remove_vehicle_due_to_fuel_exhaustion(const data::Vehicles &table, int i) {
 
-    if (vehicles[i].on_junction) {
+    if (table.on_junction[i]) {
         junction.current_number_vehicles--;
-    } else if (vehicles[i].current_road != NULL) {
-        vehicles[i].current_road->current_number_vehicles--;
-        vehicles[i].current_road->current_speed = compute_road_speed(vehicles[i].current_road);
+    } else if (table.road[i] != -1) {
+        auto &road = roads[table.road[i]];
+        road.current_number_vehicles--;
+        road.current_speed = compute_road_speed(&road);
     }
 
     // Update statistics to be sent to summary actor
-    periodic_summary.stranded_passengers += vehicles[i].passengers;
+    periodic_summary.stranded_passengers += table.passengers[i];
     periodic_summary.exhausted_vehicles++;
 }
 
@@ -299,14 +597,14 @@ int actor::JunctionAndRoads::find_appropriate_road(int dest_junction) {
 void actor::JunctionAndRoads::assign_road_to_vehicle(int i) {
 
     // Determine next junction
-    int next_junction_id = plan_route(road_map, junction.id, vehicles[i].dest_id);
+    int next_junction_id = plan_route(road_map, junction.id, vehicles.dest_id[i]);
     assert(next_junction_id != -1);
 
     // Determine road to junction
     auto road_index = find_appropriate_road(next_junction_id);
     assert(road_index != -1);
 
-    vehicles[i].current_road = &roads[road_index];
+    vehicles.road[i] = road_index;
 }
 
 /**
@@ -314,7 +612,7 @@ void actor::JunctionAndRoads::assign_road_to_vehicle(int i) {
  */
 bool actor::JunctionAndRoads::vehicle_exits_junction_with_traffic_lights(int i) {
 
-    if (vehicles[i].current_road->id == junction.road_enabled_at_traffic_lights) {
+    if (vehicles.road[i] == junction.road_enabled_at_traffic_lights) {
         junction.current_number_vehicles--;
         return true;
     } else {
@@ -328,11 +626,11 @@ bool actor::JunctionAndRoads::vehicle_exits_junction_with_traffic_lights(int i)
 bool actor::JunctionAndRoads::vehicle_exits_junction_without_traffic_lights(int i) {
 
     // Consider possibility of vehicle crashing while exiting junction
-    int collision = get_random_integer(0, 8) * junction.current_number_vehicles;
+    int collision = get_random_integer(generator, 0, 8) * junction.current_number_vehicles;
     if (collision > 40) {
         junction.summary.total_number_crashes++;
         periodic_summary.crashed_vehicles++;
-        periodic_summary.stranded_passengers += vehicles[i].passengers;
+        periodic_summary.stranded_passengers += vehicles.passengers[i];
         return false;
     }
 
@@ -341,51 +639,88 @@ bool actor::JunctionAndRoads::vehicle_exits_junction_without_traffic_lights(int
 }
 
 /**
- * Update vehicle i when entering its designated outgoing road.
+ * Move vehicle i from the junction onto its designated outgoing road, and schedule its next event on the road,
+ * i.e. reaching the end of the road or running out of fuel, whichever comes first.
+ * Returns the index of the vehicle among the vehicles on roads.
  */
-void actor::JunctionAndRoads::vehicle_enters_road(int i) {
+int actor::JunctionAndRoads::vehicle_enters_road(int i) {
+
+    auto road_index = vehicles.road[i];
+    auto &road = roads[road_index];
 
     // Update vehicle
-    vehicles[i].on_junction = false;
-    vehicles[i].remaining_distance = vehicles[i].current_road->road_length;
-    vehicles[i].speed = std::min(vehicles[i].max_speed, vehicles[i].current_road->current_speed);
-    vehicles[i].last_distance_check_secs = Timer::get_current_seconds();
+    auto vehicle = vehicles.get(i);
+    auto j = road_vehicles.add(vehicle, road_index);
+    road_vehicles.speed[j] = std::min(vehicle.max_speed, road.current_speed);
+    road_vehicles.remaining_distance[j] = road.road_length;
+    road_vehicles.last_distance_check_secs[j] = current_time;
 
     // Update road
-    vehicles[i].current_road->current_number_vehicles++;
-    vehicles[i].current_road->summary.total_number_vehicles++;
-    vehicles[i].current_road->summary.peak_number_vehicles = std::max(
-            vehicles[i].current_road->summary.peak_number_vehicles,
-            vehicles[i].current_road->current_number_vehicles);
-    vehicles[i].current_road->current_speed = compute_road_speed(vehicles[i].current_road);
+    road.current_number_vehicles++;
+    road.summary.total_number_vehicles++;
+    road.summary.peak_number_vehicles = std::max(road.summary.peak_number_vehicles, road.current_number_vehicles);
+    road.current_speed = compute_road_speed(&road);
+
+    // Schedule next event of vehicle
+    auto exhaustion_time = static_cast<double>(vehicle.start_time + vehicle.fuel + 1);
+    auto &events = road_events[road_index];
+    events.push_back(data::RoadEvent{std::min(arrival_time(j), exhaustion_time), vehicle.id});
+    std::push_heap(events.begin(), events.end(), std::greater<data::RoadEvent>());
+
+    return j;
 }
 
 /**
- * Update the remaining distance vehicle i needs to travel on the road.
+ * In real time, read the current time from the wall time of the actor, which the framework reads from the
+ * monotonic clock once per execution cycle. In logical time, the current time stays at a whole second.
  */
-void actor::JunctionAndRoads::move_vehicle_along_road(int i) {
+void actor::JunctionAndRoads::update_current_time() {
+    if (clock.mode == actor::REAL_TIME) {
+        current_time = static_cast<double>(clock.wall_time) / NANOSECONDS_PER_SECOND;
+    } else {
+        current_time = clock.local_time;
+    }
+    current_seconds = static_cast<int>(current_time);
+}
 
-    auto current_seconds = Timer::get_current_seconds();
-    auto delta_seconds = current_seconds - vehicles[i].last_distance_check_secs;
-    auto delta_length = delta_seconds * vehicles[i].speed;
+/**
+ * Returns the time at which vehicle i on a road reaches the end of the road, given the time it entered the road.
+ * In logical time, a vehicle spends a whole number of seconds on a road, at least MIN_TRAVEL_SECONDS.
+ */
+double actor::JunctionAndRoads::arrival_time(int i) {
+
+    auto speed = std::max(1, road_vehicles.speed[i]);
+    auto road_length = roads[road_vehicles.road[i]].road_length;
+    if (clock.mode == actor::REAL_TIME) {
+        return road_vehicles.last_distance_check_secs[i] + static_cast<double>(road_length) / speed;
+    }
 
-    vehicles[i].remaining_distance -= delta_length;
-    vehicles[i].last_distance_check_secs = current_seconds;
+    auto travel_seconds = (road_length + speed - 1) / speed;
+    return static_cast<int>(road_vehicles.last_distance_check_secs[i]) + std::max(MIN_TRAVEL_SECONDS, travel_seconds);
 }
 
 /**
- * When vehicle i reached the end of the road, forward it to the next junction.
+ * Forward vehicle i on a road to the next junction, which it reaches at the given time.
  */
-void actor::JunctionAndRoads::vehicle_exits_road(int i) {
+void actor::JunctionAndRoads::send_vehicle_to_next_junction(int i, int arrival_seconds) {
 
+    auto vehicle = road_vehicles.get(i);
     mail::Message message{};
-    message.data = &vehicles[i];
+    message.data = &vehicle;
     message.count = 1;
     message.mpi_datatype = MPI_VEHICLE;
-    this->mailbox.send(message, vehicles[i].current_road->dest_id);
+    message.timestamp = arrival_seconds;
+    this->mailbox.send(message, roads[road_vehicles.road[i]].dest_id);
+}
+
+/**
+ * Update the road and junction when vehicle i on a road reached the end of the road.
+ */
+void actor::JunctionAndRoads::vehicle_exits_road(int i) {
 
-    vehicles[i].current_road->current_number_vehicles--;
-    vehicles[i].current_road->current_speed = compute_road_speed(vehicles[i].current_road);
+    auto &road = roads[road_vehicles.road[i]];
+    road.current_number_vehicles--;
+    road.current_speed = compute_road_speed(&road);
     junction.current_number_vehicles--;
 }
 
@@ -394,12 +729,19 @@ void actor::JunctionAndRoads::vehicle_exits_road(int i) {
  */
 void actor::JunctionAndRoads::send_statistics_to_factory(int number_vehicles) {
 
+    // In real time, the factory actor may read the replicated counters instead
+    if (counters != nullptr) {
+        counters->add(ACTIVE_VEHICLES, -number_vehicles);
+        return;
+    }
+
     if (number_vehicles > 0) {
         mail::Message message{};
         message.data = &number_vehicles;
         message.count = 1;
         message.mpi_datatype = MPI_INT;
-        this->mailbox.send(message, factory_id);
+        message.timestamp = current_seconds + MIN_TRAVEL_SECONDS;
+        this->mailbox.reduce(message, factory_id);
     }
 }
 
@@ -408,6 +750,15 @@ void actor::JunctionAndRoads::send_statistics_to_factory(int number_vehicles) {
  */
 void actor::JunctionAndRoads::send_statistics_to_summary(int delivered, int stranded, int crashed, int exhausted) {
 
+    // In real time, the summary actor may read the replicated counters instead
+    if (counters != nullptr) {
+        counters->add(DELIVERED_PASSENGERS, delivered);
+        counters->add(STRANDED_PASSENGERS, stranded);
+        counters->add(CRASHED_VEHICLES, crashed);
+        counters->add(EXHAUSTED_VEHICLES, exhausted);
+        return;
+    }
+
     if (delivered + stranded + crashed + exhausted != 0) {
 
         auto summary = payload::PeriodicSummary(delivered, stranded, crashed, exhausted, 0);
@@ -415,7 +766,8 @@ void actor::JunctionAndRoads::send_statistics_to_summary(int delivered, int stra
         message.data = &summary;
         message.count = 1;
         message.mpi_datatype = MPI_PERIODIC_SUMMARY;
-        mailbox.send(message, summary_id);
+        message.timestamp = current_seconds + MIN_TRAVEL_SECONDS;
+        mailbox.reduce(message, summary_id);
     }
 }
 
@@ -433,6 +785,32 @@ void actor::JunctionAndRoads::send_statistics(payload::PeriodicSummary &summary)
             summary.exhausted_vehicles);
 }
 
+/**
+ * Every SNAPSHOT_FREQUENCY simulated minutes, stream the number of vehicles waiting on the junction and on each
+ * of its roads to the snapshot file of current MPI process, if snapshots are enabled. Each line reads
+ * `<simulated minutes>,<junction ID>,<destination junction ID of road, or -1 for the junction>,<vehicles>`.
+ */
+void actor::JunctionAndRoads::write_snapshot() {
+
+    auto minutes = timer.get_simulation_minutes(current_seconds);
+    if (snapshots == nullptr || minutes < next_snapshot_minutes) {
+        return;
+    }
+    while (next_snapshot_minutes <= minutes) {
+        next_snapshot_minutes += SNAPSHOT_FREQUENCY;
+    }
+
+    char line[64];
+    std::string record;
+    snprintf(line, sizeof(line), "%d,%d,-1,%d\n", minutes, id, junction.current_number_vehicles);
+    record += line;
+    for (const auto &road: roads) {
+        snprintf(line, sizeof(line), "%d,%d,%d,%d\n", minutes, id, road.dest_id, road.current_number_vehicles);
+        record += line;
+    }
+    snapshots->write(record);
+}
+
 /**
  * Send detailed summaries of simulation to the summary actor.
  * This method is meant to be called after receiving the termination message.
@@ -444,6 +822,7 @@ void actor::JunctionAndRoads::send_final_summaries() {
     message.count = 1;
     message.data = &junction.summary;
     message.mpi_datatype = MPI_JUNCTION_SUMMARY;
+    message.timestamp = current_seconds + MIN_TRAVEL_SECONDS;
     mailbox.send(message, summary_id);
 
     // Send road summaries
@@ -457,3 +836,22 @@ void actor::JunctionAndRoads::send_final_summaries() {
     message.mpi_datatype = MPI_ROAD_SUMMARY;
     mailbox.send(message, summary_id);
 }
+
+/**
+ * Write detailed summaries of simulation to the output of the framework, which writes the summaries of all
+ * junction actors to the results file once all actors stopped, as text or, with BINARY_RESULTS, as binary.
+ * This method is meant to be called after receiving the termination message.
+ */
+void actor::JunctionAndRoads::write_final_summaries() {
+
+    std::vector<payload::RoadSummary> road_summaries(roads.size());
+    for (int i = 0; i < road_summaries.size(); i++) {
+        road_summaries[i] = roads[i].summary;
+    }
+
+    if (BINARY_RESULTS) {
+        output->write(id, payload::encode_results_record(junction.summary, road_summaries));
+    } else {
+        output->write(id, payload::format_detailed_summary(junction.summary, road_summaries));
+    }
+}
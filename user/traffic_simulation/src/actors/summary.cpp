@@ -23,7 +23,7 @@ bool actor::Summary::pre_barrier_init() {
     stranded_passengers = 0;
     crashed_vehicles = 0;
     exhausted_vehicles = 0;
-    remaining_detailed_summaries = num_junctions;
+    remaining_detailed_summaries = output != nullptr ? 0 : num_junctions;
     termination_sent = false;
     junction_summaries.resize(num_junctions);
     road_summaries.resize(num_junctions);
@@ -34,7 +34,7 @@ bool actor::Summary::pre_barrier_init() {
  * Initialize `timer`.
  */
 bool actor::Summary::post_barrier_init() {
-    timer = Timer(MIN_LENGTH_SECONDS);
+    timer = Timer(MIN_LENGTH_SECONDS, 0);
     return true;
 }
 
@@ -48,6 +48,7 @@ bool actor::Summary::post_barrier_init() {
  *     - Road data meant to be written on a file
  * (4) MPI_TERMINATE
  *     - Terminate this actor
+ * In logical time, periodic summaries take effect at the time the message is stamped with (see `run`).
  */
 actor::next_step actor::Summary::ingress(mail::Message &message) {
 
@@ -55,11 +56,11 @@ actor::next_step actor::Summary::ingress(mail::Message &message) {
 
         // Receive summary from junction actors
         auto summary = (payload::PeriodicSummary *) message.data;
-        delivered_passengers += summary->delivered_passengers;
-        stranded_passengers += summary->stranded_passengers;
-        crashed_vehicles += summary->crashed_vehicles;
-        exhausted_vehicles += summary->exhausted_vehicles;
-        total_vehicles += summary->total_vehicles;
+        if (clock.mode != actor::REAL_TIME) {
+            pending_summaries.emplace(message.timestamp, *summary);
+        } else {
+            add_periodic_summary(*summary);
+        }
 
         return actor::CONTINUE;
 
@@ -91,86 +92,237 @@ actor::next_step actor::Summary::ingress(mail::Message &message) {
     }
 }
 
+/**
+ * Print a summary every simulated minute until the maximum simulated minutes, then terminate all actors
+ * and write the detailed summaries they send back to a file.
+ * In logical time, every simulated minute up to the time allowed by the framework is printed in turn, with
+ * the periodic summaries stamped up to that minute.
+ */
 actor::next_step actor::Summary::run() {
 
     if (timer.simulation_minutes < max_mins) {
 
-        if (timer.update_simulation_minutes()) {
-
-            // Print simulation progress periodically
-            if (timer.simulation_minutes % SUMMARY_FREQUENCY == 0) {
-                printf("[Time: %d mins] %d vehicles, %d passengers delivered, %d stranded passengers, %d crashed vehicles, %d vehicles exhausted fuel\n",
-                       timer.simulation_minutes,
-                       total_vehicles,
-                       delivered_passengers,
-                       stranded_passengers,
-                       crashed_vehicles,
-                       exhausted_vehicles);
-                fflush(stdout);
-            }
-
-            // Print final summary at the end of simulation
-            if (timer.simulation_minutes >= max_mins) {
-                printf("Finished after %d mins: %d vehicles, %d passengers delivered, %d passengers stranded, %d crashed vehicles, %d vehicles exhausted fuel\n",
-                       max_mins,
-                       total_vehicles,
-                       delivered_passengers,
-                       stranded_passengers,
-                       crashed_vehicles,
-                       exhausted_vehicles);
-                fflush(stdout);
+        if (clock.mode != actor::REAL_TIME) {
+            for (auto t = next_event_time(); t < clock.safe_time; t = next_event_time()) {
+                timer.update_simulation_minutes(static_cast<int>(t));
+                while (!pending_summaries.empty() && pending_summaries.begin()->first <= t) {
+                    add_periodic_summary(pending_summaries.begin()->second);
+                    pending_summaries.erase(pending_summaries.begin());
+                }
+                print_progress();
             }
+        } else if (timer.update_simulation_minutes(static_cast<int>(clock.wall_time / NANOSECONDS_PER_SECOND))) {
+            print_progress();
         }
 
-        return actor::CONTINUE;
-
-    } else {
-
-        // Send termination messages to all actors
-        if (!termination_sent) {
-
-            double start_time = MPI_Wtime();
-            send_terminate();
-            double end_time = MPI_Wtime();
-
-            if (LOG_DEBUG) {
-                printf("[DEBUG] Summary send_terminate() takes %f seconds\n", end_time - start_time);
-                fflush(stdout);
-            }
-
-            termination_sent = true;
+        // In logical time, terminate messages are sent right after the last simulated minute, since they are
+        // stamped one lookahead after it
+        if (clock.mode == actor::REAL_TIME || timer.simulation_minutes < max_mins) {
             return actor::CONTINUE;
         }
+    }
 
-        // Wait until detailed summaries from all junction actors have been received
-        if (remaining_detailed_summaries != 0) {
-            return actor::CONTINUE;
-        }
+    // Send termination messages to all actors
+    if (!termination_sent) {
 
-        // Write detailed summaries to a file
         double start_time = MPI_Wtime();
-        write_detailed_info();
+        send_terminate();
         double end_time = MPI_Wtime();
 
         if (LOG_DEBUG) {
-            printf("[DEBUG] Summary write_detailed_info() takes %f seconds\n", end_time - start_time);
+            printf("[DEBUG] Summary send_terminate() takes %f seconds\n", end_time - start_time);
             fflush(stdout);
         }
 
+        termination_sent = true;
+        return actor::CONTINUE;
+    }
+
+    // Junction actors write their detailed summaries via the output of the framework, if enabled
+    if (output != nullptr) {
         return actor::STOP;
     }
+
+    // Wait until detailed summaries from all junction actors have been received
+    if (remaining_detailed_summaries != 0) {
+        return actor::CONTINUE;
+    }
+
+    // Write detailed summaries to a file
+    double start_time = MPI_Wtime();
+    write_detailed_info();
+    double end_time = MPI_Wtime();
+
+    if (LOG_DEBUG) {
+        printf("[DEBUG] Summary write_detailed_info() takes %f seconds\n", end_time - start_time);
+        fflush(stdout);
+    }
+
+    return actor::STOP;
 }
 
 /**
- * Send terminate message to all actors.
+ * In logical time, returns the start of the next simulated minute until the maximum simulated minutes.
+ */
+double actor::Summary::next_event_time() {
+    if (timer.simulation_minutes >= max_mins) {
+        return NO_EVENT;
+    }
+    return (timer.simulation_minutes + 1) * MIN_LENGTH_SECONDS;
+}
+
+/**
+ * In logical time, terminate messages are stamped MIN_TRAVEL_SECONDS after the last simulated minute.
+ */
+double actor::Summary::lookahead() {
+    return MIN_TRAVEL_SECONDS;
+}
+
+/**
+ * Terminate messages are sent to all junctions and the factory actor.
+ */
+std::vector<actor::id> actor::Summary::channels() {
+
+    std::vector<actor::id> ids;
+    for (int i = 0; i < num_junctions; i++) {
+        ids.push_back(i);
+    }
+    ids.push_back(factory_id);
+
+    return ids;
+}
+
+/**
+ * On the global stop, which this actor requested, keep running until the detailed summaries are written
+ * (see `run`).
+ */
+actor::next_step actor::Summary::terminate() {
+    return actor::CONTINUE;
+}
+
+/**
+ * Write the state of the summary actor to a checkpoint. The summary actor does not support serialization
+ * otherwise, so that it is not rolled back in optimistic execution, where it prints progress.
+ */
+bool actor::Summary::checkpoint(actor::Serializer &serializer) {
+
+    serializer.write(factory_id);
+    serializer.write(num_junctions);
+    serializer.write(initial_vehicles);
+    serializer.write(max_mins);
+
+    serializer.write(total_vehicles);
+    serializer.write(delivered_passengers);
+    serializer.write(stranded_passengers);
+    serializer.write(crashed_vehicles);
+    serializer.write(exhausted_vehicles);
+    serializer.write(remaining_detailed_summaries);
+    serializer.write(termination_sent);
+    serializer.write(timer);
+
+    serializer.write(junction_summaries);
+    for (const auto &summaries: road_summaries) {
+        serializer.write(summaries);
+    }
+
+    return true;
+}
+
+/**
+ * Restore the state of the summary actor from a checkpoint.
+ */
+bool actor::Summary::restore(actor::Deserializer &deserializer) {
+
+    deserializer.read(factory_id);
+    deserializer.read(num_junctions);
+    deserializer.read(initial_vehicles);
+    deserializer.read(max_mins);
+
+    deserializer.read(total_vehicles);
+    deserializer.read(delivered_passengers);
+    deserializer.read(stranded_passengers);
+    deserializer.read(crashed_vehicles);
+    deserializer.read(exhausted_vehicles);
+    deserializer.read(remaining_detailed_summaries);
+    deserializer.read(termination_sent);
+    deserializer.read(timer);
+
+    deserializer.read(junction_summaries);
+    road_summaries.resize(junction_summaries.size());
+    for (auto &summaries: road_summaries) {
+        deserializer.read(summaries);
+    }
+
+    return true;
+}
+
+/**
+ * Add the statistics of a periodic summary from a junction actor to the totals.
+ */
+void actor::Summary::add_periodic_summary(const payload::PeriodicSummary &summary) {
+    delivered_passengers += summary.delivered_passengers;
+    stranded_passengers += summary.stranded_passengers;
+    crashed_vehicles += summary.crashed_vehicles;
+    exhausted_vehicles += summary.exhausted_vehicles;
+    total_vehicles += summary.total_vehicles;
+}
+
+/**
+ * Print simulation progress periodically, and the final summary at the end of simulation.
+ */
+void actor::Summary::print_progress() {
+
+    // In real time, statistics may be read from the replicated counters
+    if (counters != nullptr) {
+        total_vehicles = initial_vehicles + static_cast<int>(counters->get(NEW_VEHICLES));
+        delivered_passengers = static_cast<int>(counters->get(DELIVERED_PASSENGERS));
+        stranded_passengers = static_cast<int>(counters->get(STRANDED_PASSENGERS));
+        crashed_vehicles = static_cast<int>(counters->get(CRASHED_VEHICLES));
+        exhausted_vehicles = static_cast<int>(counters->get(EXHAUSTED_VEHICLES));
+    }
+
+    // Print simulation progress periodically
+    if (timer.simulation_minutes % SUMMARY_FREQUENCY == 0) {
+        printf("[Time: %d mins] %d vehicles, %d passengers delivered, %d stranded passengers, %d crashed vehicles, %d vehicles exhausted fuel\n",
+               timer.simulation_minutes,
+               total_vehicles,
+               delivered_passengers,
+               stranded_passengers,
+               crashed_vehicles,
+               exhausted_vehicles);
+        fflush(stdout);
+    }
+
+    // Print final summary at the end of simulation
+    if (timer.simulation_minutes >= max_mins) {
+        printf("Finished after %d mins: %d vehicles, %d passengers delivered, %d passengers stranded, %d crashed vehicles, %d vehicles exhausted fuel\n",
+               max_mins,
+               total_vehicles,
+               delivered_passengers,
+               stranded_passengers,
+               crashed_vehicles,
+               exhausted_vehicles);
+        fflush(stdout);
+    }
+}
+
+/**
+ * Send terminate message to all actors or, with global termination, request the global stop of all actors
+ * from the framework.
  */
 void actor::Summary::send_terminate() {
 
+    if (termination != nullptr) {
+        termination->request();
+        return;
+    }
+
     payload::Terminate terminate{};
     mail::Message message;
     message.count = 1;
     message.data = &terminate;
     message.mpi_datatype = MPI_TERMINATE;
+    message.timestamp = max_mins * MIN_LENGTH_SECONDS + MIN_TRAVEL_SECONDS;
 
     // Send terminate message to all junction actors
     for (int i = 0; i < num_junctions; i++) {
@@ -188,15 +340,8 @@ void actor::Summary::write_detailed_info() {
 
     FILE *f = fopen("results", "w");
     for (int i = 0; i < num_junctions; i++) {
-        fprintf(f, "Junction %d: %d total vehicles and %d crashes\n",
-                i, junction_summaries[i].total_number_vehicles, junction_summaries[i].total_number_crashes);
-        for (int j = 0; j < road_summaries[i].size(); j++) {
-            fprintf(f, "--> Road from %d to %d: Total vehicles %d and %d maximum concurrently\n",
-                    road_summaries[i][j].source_id,
-                    road_summaries[i][j].dest_id,
-                    road_summaries[i][j].total_number_vehicles,
-                    road_summaries[i][j].peak_number_vehicles);
-        }
+        junction_summaries[i].id = i;
+        fputs(payload::format_detailed_summary(junction_summaries[i], road_summaries[i]).c_str(), f);
     }
     fclose(f);
 }
\ No newline at end of file
@@ -13,6 +13,7 @@
 #include "payload/terminate.h"
 #include "payload/vehicle.h"
 #include "payload/summary.h"
+#include "payload/results.h"
 #include "main.h"
 
 /**
@@ -27,6 +28,7 @@
  * (6) Road length scale down factor
  * (7) Road length minimum
  * (8) Vehicle fuel scale up factor
+ * (9) Optionally, filename of a checkpoint to resume from
  *
  * To use the default values of road length and vehicle fuel capacities, set the following parameters as follows:
  * - Road length scale down factor to 1
@@ -35,12 +37,13 @@
  */
 int main(int argc, char *argv[]) {
 
-    if (argc != 9) {
-        fprintf(stderr, "ERROR: expected 8 arguments\n");
+    if (argc != 9 && argc != 10) {
+        fprintf(stderr, "ERROR: expected 8 or 9 arguments\n");
         return EXIT_FAILURE;
     }
 
-    MPI_Init(&argc, &argv);
+    int thread_level;
+    MPI_Init_thread(&argc, &argv, MPI_THREAD_FUNNELED, &thread_level);
     double start_time = MPI_Wtime();
     set_random_seed(RANDOM_SEED);
 
@@ -54,6 +57,7 @@ int main(int argc, char *argv[]) {
     int road_length_scale_down = std::stoi(argv[6]);
     int road_length_minimum = std::stoi(argv[7]);
     int fuel_scale_up = std::stoi(argv[8]);
+    std::string restore_file = argc == 10 ? argv[9] : "";
     auto road_map_info = map::RoadMapInfo(road_map_file, road_length_scale_down, road_length_minimum, fuel_scale_up);
     map::get_num_junctions_and_roads(road_map_info, num_junctions, num_roads);
 
@@ -61,12 +65,23 @@ int main(int argc, char *argv[]) {
     auto ingress_mode = true;
     auto log_debug = LOG_DEBUG ? true : false;
     auto framework = ParallelActorModel(num_actors_per_procs, ingress_mode, log_debug);
+    framework.setTimeMode(TIME_MODE);
 
     // Setup framework (i.e. add actors and message data type)
+    set_junction_placement(framework, road_map_info);
     add_junction_actors(framework, num_junctions, initial_vehicles, road_map_info);
+    enable_junction_migration(framework, num_junctions, road_map_info);
     add_factory_actor(framework, num_junctions, initial_vehicles, max_vehicles, road_map_info);
     add_summary_actor(framework, num_junctions, initial_vehicles, max_mins);
     add_message_datatype(framework);
+    add_statistics_reductions(framework, num_junctions);
+    enable_statistics_counters(framework);
+    enable_parallel_results(framework);
+    enable_snapshots(framework);
+    enable_global_termination(framework);
+    enable_checkpoints(framework, restore_file);
+    enable_profiling(framework);
+    enable_tracing(framework);
     print_problem_size(framework, num_junctions, num_roads, initial_vehicles);
 
     // Launch framework execution cycle
@@ -74,12 +89,51 @@ int main(int argc, char *argv[]) {
 
     MPI_Barrier(MPI_COMM_WORLD);
     double end_time = MPI_Wtime();
-    print_execution_time(framework, log_debug, start_time, end_time);
+    print_execution_time(framework, log_debug, max_mins, start_time, end_time);
     MPI_Finalize();
 
     return EXIT_SUCCESS;
 }
 
+/**
+ * Describe the junction actors to the framework so that it can place them on MPI processes:
+ *
+ * - With TOPOLOGY_AWARE_PLACEMENT, the road network is provided as the communication graph between junction actors.
+ *   The framework places junction actors connected by roads on the same MPI process where possible,
+ *   so that most vehicles are handed over without leaving the MPI process.
+ * - With WEIGHTED_PLACEMENT, each junction actor is weighted by the number of roads it is connected to.
+ *   Vehicles concentrate on junctions with many roads, so the framework balances total weight per MPI process.
+ */
+void set_junction_placement(ParallelActorModel &framework, map::RoadMapInfo road_map_info) {
+
+    if (!TOPOLOGY_AWARE_PLACEMENT && !WEIGHTED_PLACEMENT) {
+        return;
+    }
+
+    graph::RoadMap road_map;
+    map::load(road_map_info, road_map);
+
+    auto adjacency = std::vector<std::vector<int>>(road_map.size());
+    auto weights = std::vector<int>(road_map.size(), 1);
+    for (const auto &junction: road_map) {
+        for (const auto &road: junction.roads) {
+            adjacency[junction.id].push_back(road.dest->id);
+            if (WEIGHTED_PLACEMENT) {
+                weights[junction.id]++;
+                weights[road.dest->id]++;
+            }
+        }
+    }
+
+    if (TOPOLOGY_AWARE_PLACEMENT) {
+        auto graph = placement::Graph(adjacency);
+        graph.vwgt = weights;
+        framework.setTopology(graph);
+    } else {
+        framework.setWeights(weights);
+    }
+}
+
 /**
  * Create and add junction actors to the framework.
  */
@@ -90,11 +144,7 @@ void add_junction_actors(ParallelActorModel &framework, int num_junctions, int i
     auto summary_id = num_junctions + 1;
 
     // Assign random number of initial vehicles to each junction
-    auto initial_vehicles_by_junction = std::unordered_map<int, int>();
-
-    for (int junction_id = 0; junction_id < num_junctions; junction_id++) {
-        initial_vehicles_by_junction[junction_id] = 0;
-    }
+    auto initial_vehicles_by_junction = std::vector<int>(num_junctions, 0);
 
     for (int i = 0; i < initial_vehicles; i++) {
         auto junction_id = get_random_integer(0, num_junctions);
@@ -109,20 +159,41 @@ void add_junction_actors(ParallelActorModel &framework, int num_junctions, int i
     int initial_vehicle_id = 0;
     for (int actor_id = 0; actor_id < num_junctions; actor_id++) {
 
+        // Only the MPI process handling the junction actor creates it
         auto initial_vehicle_size = initial_vehicles_by_junction[actor_id];
-        auto actor = new actor::JunctionAndRoads(
-                actor_id,
-                factory_id,
-                summary_id,
-                initial_vehicle_id,
-                initial_vehicle_size,
-                road_map_info);
-
-        framework.addActor(actor);
+        framework.addActor(actor_id, [&](actor::id id) -> actor::Actor * {
+            return new actor::JunctionAndRoads(
+                    id,
+                    factory_id,
+                    summary_id,
+                    initial_vehicle_id,
+                    initial_vehicle_size,
+                    road_map_info);
+        });
+
         initial_vehicle_id += initial_vehicle_size;
     }
 }
 
+/**
+ * Allow junction actors to migrate between MPI processes when DYNAMIC_MIGRATION is set.
+ * Traffic hot spots move during the simulation, so the framework periodically moves junction actors
+ * from overloaded to underloaded MPI processes.
+ */
+void enable_junction_migration(ParallelActorModel &framework, int num_junctions, map::RoadMapInfo road_map_info) {
+
+    if (!DYNAMIC_MIGRATION) {
+        return;
+    }
+
+    // The state of a migrated junction actor is restored by its `deserialize` method
+    auto factory_id = num_junctions;
+    auto summary_id = num_junctions + 1;
+    framework.enableMigration([factory_id, summary_id, road_map_info](actor::id id) mutable -> actor::Actor * {
+        return new actor::JunctionAndRoads(id, factory_id, summary_id, 0, 0, road_map_info);
+    });
+}
+
 /**
  * Create and add factory actor to the framework.
  * The factory actor periodically adds new vehicles to the simulation.
@@ -131,8 +202,9 @@ void add_factory_actor(ParallelActorModel &framework, int num_junctions, int ini
                        map::RoadMapInfo road_map_info) {
     auto factory_id = num_junctions;
     auto summary_id = num_junctions + 1;
-    auto factory_actor = new actor::Factory(factory_id, summary_id, initial_vehicles, max_vehicles, road_map_info);
-    framework.addIsolatedActor(factory_actor);
+    framework.addIsolatedActor(factory_id, [&](actor::id id) -> actor::Actor * {
+        return new actor::Factory(id, summary_id, initial_vehicles, max_vehicles, road_map_info);
+    });
 }
 
 /**
@@ -142,8 +214,9 @@ void add_factory_actor(ParallelActorModel &framework, int num_junctions, int ini
 void add_summary_actor(ParallelActorModel &framework, int num_junctions, int initial_vehicles, int max_mins) {
     auto factory_id = num_junctions;
     auto summary_id = num_junctions + 1;
-    auto summary_actor = new actor::Summary(summary_id, factory_id, num_junctions, initial_vehicles, max_mins);
-    framework.addIsolatedActor(summary_actor);
+    framework.addIsolatedActor(summary_id, [&](actor::id id) -> actor::Actor * {
+        return new actor::Summary(id, factory_id, num_junctions, initial_vehicles, max_mins);
+    });
 }
 
 /**
@@ -160,13 +233,146 @@ void add_message_datatype(ParallelActorModel &framework) {
 
     // Register datatypes to framework
     framework.addType(mail::Type{sizeof(int), MPI_INT});
-    framework.addType(mail::Type{sizeof(payload::Vehicle), MPI_VEHICLE});
+    if (COMPACT_VEHICLES) {
+        framework.addType(mail::Type{sizeof(payload::Vehicle), MPI_VEHICLE, payload::encode_vehicles,
+                                     payload::decode_vehicles});
+    } else {
+        framework.addType(mail::Type{sizeof(payload::Vehicle), MPI_VEHICLE});
+    }
     framework.addType(mail::Type{sizeof(payload::Terminate), MPI_TERMINATE});
     framework.addType(mail::Type{sizeof(payload::PeriodicSummary), MPI_PERIODIC_SUMMARY});
     framework.addType(mail::Type{sizeof(payload::JunctionSummary), MPI_JUNCTION_SUMMARY});
     framework.addType(mail::Type{sizeof(payload::RoadSummary), MPI_ROAD_SUMMARY});
 }
 
+/**
+ * With REDUCED_STATISTICS, the framework sums the statistics that junction actors send to the factory and summary
+ * actors across all MPI processes, so that these actors receive one message per reduction epoch rather than one
+ * message per junction actor.
+ */
+void add_statistics_reductions(ParallelActorModel &framework, int num_junctions) {
+
+    if (!REDUCED_STATISTICS) {
+        return;
+    }
+
+    auto factory_id = num_junctions;
+    auto summary_id = num_junctions + 1;
+    framework.addReduction(factory_id, MPI_INT);
+    framework.addReduction(summary_id, MPI_PERIODIC_SUMMARY);
+}
+
+/**
+ * With REPLICATED_COUNTERS, junction and factory actors keep the statistics in counters replicated by the
+ * framework on all MPI processes, rather than sending them to the factory and summary actors, which read them
+ * with a staleness of a few reduction epochs.
+ */
+void enable_statistics_counters(ParallelActorModel &framework) {
+
+    if (!REPLICATED_COUNTERS) {
+        return;
+    }
+
+    framework.enableCounters(NUM_COUNTERS);
+}
+
+/**
+ * With PARALLEL_RESULTS, junction actors write their detailed summaries via the output of the framework, which
+ * writes the results file collectively from all MPI processes, rather than sending them to the summary actor.
+ * With BINARY_RESULTS, each MPI process writes the summaries of its junction actors as binary columns instead
+ * (see `payload::ResultsHeader`).
+ */
+void enable_parallel_results(ParallelActorModel &framework) {
+
+    if (!PARALLEL_RESULTS) {
+        return;
+    }
+
+    if (BINARY_RESULTS) {
+        framework.enableOutput("results.bin", payload::encode_results_chunk);
+    } else {
+        framework.enableOutput("results");
+    }
+}
+
+/**
+ * With SNAPSHOT_FREQUENCY, junction actors stream the number of vehicles on the junction and on each of its
+ * roads every SNAPSHOT_FREQUENCY simulated minutes to the snapshot file of their MPI process, which the framework
+ * writes from a background thread.
+ */
+void enable_snapshots(ParallelActorModel &framework) {
+
+    if (SNAPSHOT_FREQUENCY <= 0) {
+        return;
+    }
+
+    int thread_level;
+    MPI_Query_thread(&thread_level);
+    if (thread_level < MPI_THREAD_FUNNELED) {
+        fprintf(stderr, "ERROR: snapshots require MPI_THREAD_FUNNELED\n");
+        return;
+    }
+
+    framework.enableSnapshots("snapshots");
+}
+
+/**
+ * With GLOBAL_TERMINATION, the summary actor requests the global stop from the framework at the end of
+ * simulation, which notifies all actors on every MPI process, rather than sending a terminate message to each
+ * junction actor and to the factory actor. In logical time, terminate messages are still sent, since they
+ * are stamped with the end of simulation.
+ */
+void enable_global_termination(ParallelActorModel &framework) {
+
+    if (!GLOBAL_TERMINATION) {
+        return;
+    }
+
+    framework.enableTermination();
+}
+
+/**
+ * With CHECKPOINT_INTERVAL, the framework writes a checkpoint of all actors to the file "checkpoint" every
+ * CHECKPOINT_INTERVAL seconds, e.g. to resume runs killed by the wall time limit of their job. If a checkpoint is
+ * given on the command line, actors resume from it, possibly on a different number of MPI processes.
+ */
+void enable_checkpoints(ParallelActorModel &framework, const std::string &restore_file) {
+
+    if (CHECKPOINT_INTERVAL > 0) {
+        framework.enableCheckpoints("checkpoint", CHECKPOINT_INTERVAL);
+    }
+
+    if (!restore_file.empty()) {
+        framework.restoreCheckpoint(restore_file);
+    }
+}
+
+/**
+ * With PROFILING, the framework measures the time spent in each actor and counts messages and bytes by type,
+ * which each MPI process writes to profile.<rank>.json once all actors stopped, while rank 0 prints a summary.
+ */
+void enable_profiling(ParallelActorModel &framework) {
+
+    if (!PROFILING) {
+        return;
+    }
+
+    framework.enableProfiling("profile");
+}
+
+/**
+ * With TRACING, the framework records when each actor processes messages and runs, and when messages are sent
+ * and received, which all MPI processes write to trace.json once all actors stopped.
+ */
+void enable_tracing(ParallelActorModel &framework) {
+
+    if (!TRACING) {
+        return;
+    }
+
+    framework.enableTracing("trace.json");
+}
+
 /**
  * Display the problem size.
  */
@@ -180,10 +386,15 @@ void print_problem_size(ParallelActorModel &framework, int num_junctions, int nu
 
 /**
  * Prints the execution time of the simulation when the log leve is set to debug.
+ * In logical time, the simulation runs as fast as it can, so its throughput is printed as well.
  */
-void print_execution_time(ParallelActorModel &framework, int log_debug, double start_time, double end_time) {
+void print_execution_time(ParallelActorModel &framework, int log_debug, int max_mins, double start_time,
+                          double end_time) {
     if (framework.rank == 0 && log_debug) {
         printf("[DEBUG] Execution time is %f\n", end_time - start_time);
+        if (framework.time_mode != actor::REAL_TIME) {
+            printf("[DEBUG] Simulated %f minutes per second\n", max_mins / (end_time - start_time));
+        }
         fflush(stdout);
     }
 }
@@ -0,0 +1,190 @@
+#include <cstdlib>
+#include <tuple>
+#include "map/vehicles.h"
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+/**
+ * Returns the number of vehicles.
+ */
+int data::Vehicles::size() const {
+    return static_cast<int>(id.size());
+}
+
+/**
+ * Append a vehicle on the given road, or a vehicle waiting on the junction if the road is -1, i.e. not assigned
+ * yet. The state of the vehicle within the junction starts at zero. Returns the index of the vehicle.
+ */
+int data::Vehicles::add(const payload::Vehicle &vehicle, int road_index) {
+    slots[vehicle.id] = size();
+    id.push_back(vehicle.id);
+    fuel.push_back(vehicle.fuel);
+    max_speed.push_back(vehicle.max_speed);
+    passengers.push_back(vehicle.passengers);
+    source_id.push_back(vehicle.source_id);
+    dest_id.push_back(vehicle.dest_id);
+    start_time.push_back(vehicle.start_time);
+    speed.push_back(0);
+    road.push_back(road_index);
+    on_junction.push_back(road_index == -1);
+    remaining_distance.push_back(0);
+    last_distance_check_secs.push_back(0);
+    return size() - 1;
+}
+
+/**
+ * Returns vehicle i as the vehicle object sent between junction actors.
+ */
+payload::Vehicle data::Vehicles::get(int i) const {
+    auto vehicle = payload::Vehicle(id[i], fuel[i], max_speed[i], passengers[i], source_id[i], dest_id[i]);
+    vehicle.start_time = start_time[i];
+    return vehicle;
+}
+
+/**
+ * Remove vehicle i by moving the last vehicle into its slot.
+ */
+void data::Vehicles::remove(int i) {
+
+    auto last = size() - 1;
+    slots.erase(id[i]);
+    if (i != last) {
+        slots[id[last]] = i;
+    }
+
+    id[i] = id[last];
+    fuel[i] = fuel[last];
+    max_speed[i] = max_speed[last];
+    passengers[i] = passengers[last];
+    source_id[i] = source_id[last];
+    dest_id[i] = dest_id[last];
+    start_time[i] = start_time[last];
+    speed[i] = speed[last];
+    road[i] = road[last];
+    on_junction[i] = on_junction[last];
+    remaining_distance[i] = remaining_distance[last];
+    last_distance_check_secs[i] = last_distance_check_secs[last];
+
+    id.pop_back();
+    fuel.pop_back();
+    max_speed.pop_back();
+    passengers.pop_back();
+    source_id.pop_back();
+    dest_id.pop_back();
+    start_time.pop_back();
+    speed.pop_back();
+    road.pop_back();
+    on_junction.pop_back();
+    remaining_distance.pop_back();
+    last_distance_check_secs.pop_back();
+}
+
+/**
+ * Remove vehicle i, and move the flag of the last vehicle into its slot so that the flags stay in step
+ * with the vehicles.
+ */
+void data::Vehicles::remove(int i, std::vector<char> &flags) {
+    remove(i);
+    flags[i] = flags.back();
+    flags.pop_back();
+}
+
+/**
+ * Set exhausted[i] to 1 if vehicle i runs out of fuel by the given time, and to 0 otherwise.
+ * When compiled with AVX2, eight vehicles are checked per instruction and the scalar loop checks the
+ * remaining ones. Otherwise, the scalar loop checks all vehicles.
+ */
+void data::Vehicles::find_exhausted(int seconds, std::vector<char> &exhausted) const {
+
+    auto n = size();
+    exhausted.resize(n);
+
+    int i = 0;
+#ifdef __AVX2__
+    auto now = _mm256_set1_epi32(seconds);
+    for (; i + 8 <= n; i += 8) {
+        auto start = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(&start_time[i]));
+        auto tank = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(&fuel[i]));
+        auto out_of_fuel = _mm256_cmpgt_epi32(_mm256_sub_epi32(now, start), tank);
+        auto bits = _mm256_movemask_ps(_mm256_castsi256_ps(out_of_fuel));
+        for (int k = 0; k < 8; k++) {
+            exhausted[i + k] = static_cast<char>((bits >> k) & 1);
+        }
+    }
+#endif
+
+    for (; i < n; i++) {
+        exhausted[i] = seconds - start_time[i] > fuel[i];
+    }
+}
+
+/**
+ * Remove all vehicles.
+ */
+void data::Vehicles::clear() {
+    slots.clear();
+    id.clear();
+    fuel.clear();
+    max_speed.clear();
+    passengers.clear();
+    source_id.clear();
+    dest_id.clear();
+    start_time.clear();
+    speed.clear();
+    road.clear();
+    on_junction.clear();
+    remaining_distance.clear();
+    last_distance_check_secs.clear();
+}
+
+/**
+ * Write all vehicles, array by array.
+ */
+void data::Vehicles::serialize(actor::Serializer &serializer) const {
+    serializer.write(id);
+    serializer.write(fuel);
+    serializer.write(max_speed);
+    serializer.write(passengers);
+    serializer.write(source_id);
+    serializer.write(dest_id);
+    serializer.write(start_time);
+    serializer.write(speed);
+    serializer.write(road);
+    serializer.write(on_junction);
+    serializer.write(remaining_distance);
+    serializer.write(last_distance_check_secs);
+}
+
+/**
+ * Read back all vehicles written by `serialize`, replacing the current vehicles.
+ */
+void data::Vehicles::deserialize(actor::Deserializer &deserializer) {
+    deserializer.read(id);
+    deserializer.read(fuel);
+    deserializer.read(max_speed);
+    deserializer.read(passengers);
+    deserializer.read(source_id);
+    deserializer.read(dest_id);
+    deserializer.read(start_time);
+    deserializer.read(speed);
+    deserializer.read(road);
+    deserializer.read(on_junction);
+    deserializer.read(remaining_distance);
+    deserializer.read(last_distance_check_secs);
+
+    slots.clear();
+    for (int i = 0; i < size(); i++) {
+        slots[id[i]] = i;
+    }
+}
+
+/**
+ * Events are ordered by time, then by vehicle ID, so that simultaneous events are processed in the same order
+ * on every run.
+ */
+bool data::RoadEvent::operator>(const data::RoadEvent &other) const {
+    return std::make_tuple(time, vehicle_id) > std::make_tuple(other.time, other.vehicle_id);
+}
+
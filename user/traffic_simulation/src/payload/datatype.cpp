@@ -24,15 +24,12 @@ MPI_Datatype MPI_ROAD_SUMMARY;
  */
 void MPI_Create_vehicle_datatype() {
 
-    payload::Vehicle vehicle;
+    payload::Vehicle vehicle{};
 
-    const int count = 2;
-    int num_integers = 9;
-    int num_double = 1;
-
-    int block_lengths[count] = {num_integers, num_double};
+    const int count = 1;
+    int block_lengths[count] = {payload::VEHICLE_NUM_INTEGERS};
     MPI_Aint displacements[count];
-    MPI_Datatype types[count] = {MPI_INT, MPI_DOUBLE};
+    MPI_Datatype types[count] = {MPI_INT};
 
     // Determine displacements
     MPI_Aint start_address;
@@ -42,9 +39,6 @@ void MPI_Create_vehicle_datatype() {
     MPI_Get_address(&vehicle.id, &offset_address);
     displacements[0] = MPI_Aint_diff(offset_address, start_address);
 
-    MPI_Get_address(&vehicle.remaining_distance, &offset_address);
-    displacements[1] = MPI_Aint_diff(offset_address, start_address);
-
     // Create MPI type
     MPI_Type_create_struct(count, block_lengths, displacements, types, &MPI_VEHICLE);
     MPI_Type_commit(&MPI_VEHICLE);
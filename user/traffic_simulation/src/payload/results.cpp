@@ -0,0 +1,124 @@
+#include <cstring>
+#include "payload/results.h"
+
+#define JUNCTION_COLUMNS 4
+#define ROAD_COLUMNS 4
+
+/**
+ * Append a column of ints to the given bytes.
+ */
+static void append_column(std::string &bytes, const std::vector<int> &column) {
+    bytes.append(reinterpret_cast<const char *>(column.data()), column.size() * sizeof(int));
+}
+
+/**
+ * Read a column of the given number of ints from the given bytes, advancing the position.
+ */
+static void read_column(const std::string &bytes, long &position, int count, std::vector<int> &column) {
+    column.resize(count);
+    std::memcpy(column.data(), bytes.data() + position, count * sizeof(int));
+    position += static_cast<long>(count * sizeof(int));
+}
+
+/**
+ * Returns the record of a junction and its roads written by its junction actor, i.e. the row of the junction
+ * followed by the rows of its roads, to be laid out by columns by `encode_results_chunk`.
+ */
+std::string payload::encode_results_record(const JunctionSummary &junction, const std::vector<RoadSummary> &roads) {
+
+    std::vector<int> row = {junction.id, junction.total_number_vehicles, junction.total_number_crashes,
+                            static_cast<int>(roads.size())};
+    for (const auto &road: roads) {
+        row.insert(row.end(), {road.source_id, road.dest_id, road.total_number_vehicles, road.peak_number_vehicles});
+    }
+
+    std::string record;
+    append_column(record, row);
+    return record;
+}
+
+/**
+ * Returns the chunk of the binary results file holding the records of the junction actors of an MPI process
+ * (see `payload::ResultsHeader`).
+ */
+std::string payload::encode_results_chunk(const std::map<long, std::string> &records) {
+
+    std::vector<std::vector<int>> junction_table(JUNCTION_COLUMNS);
+    std::vector<std::vector<int>> road_table(ROAD_COLUMNS);
+    std::vector<int> row;
+
+    for (const auto &kv: records) {
+        row.resize(kv.second.size() / sizeof(int));
+        std::memcpy(row.data(), kv.second.data(), row.size() * sizeof(int));
+        for (int c = 0; c < JUNCTION_COLUMNS; c++) {
+            junction_table[c].push_back(row[c]);
+        }
+        for (int i = JUNCTION_COLUMNS; i + ROAD_COLUMNS <= row.size(); i += ROAD_COLUMNS) {
+            for (int c = 0; c < ROAD_COLUMNS; c++) {
+                road_table[c].push_back(row[i + c]);
+            }
+        }
+    }
+
+    auto header = ResultsHeader{RESULTS_MAGIC, static_cast<int>(junction_table[0].size()),
+                                static_cast<int>(road_table[0].size())};
+    std::string chunk(reinterpret_cast<const char *>(&header), sizeof(ResultsHeader));
+    for (const auto &column: junction_table) {
+        append_column(chunk, column);
+    }
+    for (const auto &column: road_table) {
+        append_column(chunk, column);
+    }
+
+    return chunk;
+}
+
+/**
+ * Read the chunk of the binary results file at the given position, advancing the position, and append its
+ * junctions and their roads. Returns false if the bytes at the position are not a complete chunk.
+ */
+bool payload::decode_results_chunk(const std::string &bytes, long &position, std::vector<JunctionSummary> &junctions,
+                                   std::vector<std::vector<RoadSummary>> &roads) {
+
+    ResultsHeader header{};
+    if (position + static_cast<long>(sizeof(ResultsHeader)) > bytes.size()) {
+        return false;
+    }
+    std::memcpy(&header, bytes.data() + position, sizeof(ResultsHeader));
+
+    auto size = static_cast<long>(sizeof(int)) * (JUNCTION_COLUMNS * header.num_junctions +
+                                                  ROAD_COLUMNS * header.num_roads);
+    if (header.magic != RESULTS_MAGIC || header.num_junctions < 0 || header.num_roads < 0
+        || position + static_cast<long>(sizeof(ResultsHeader)) + size > bytes.size()) {
+        return false;
+    }
+    position += sizeof(ResultsHeader);
+
+    std::vector<std::vector<int>> junction_table(JUNCTION_COLUMNS);
+    std::vector<std::vector<int>> road_table(ROAD_COLUMNS);
+    for (auto &column: junction_table) {
+        read_column(bytes, position, header.num_junctions, column);
+    }
+    for (auto &column: road_table) {
+        read_column(bytes, position, header.num_roads, column);
+    }
+
+    int road = 0;
+    for (int j = 0; j < header.num_junctions; j++) {
+
+        auto junction = JunctionSummary(junction_table[0][j]);
+        junction.total_number_vehicles = junction_table[1][j];
+        junction.total_number_crashes = junction_table[2][j];
+        junctions.push_back(junction);
+
+        roads.emplace_back();
+        for (int i = 0; i < junction_table[3][j] && road < header.num_roads; i++, road++) {
+            auto summary = RoadSummary(road_table[0][road], road_table[1][road]);
+            summary.total_number_vehicles = road_table[2][road];
+            summary.peak_number_vehicles = road_table[3][road];
+            roads.back().push_back(summary);
+        }
+    }
+
+    return true;
+}
@@ -1,4 +1,5 @@
 
+#include <cstdio>
 #include "payload/summary.h"
 
 
@@ -24,3 +25,22 @@ payload::PeriodicSummary::PeriodicSummary(int delivered, int stranded, int crash
         crashed_vehicles(crashed),
         exhausted_vehicles(exhausted),
         total_vehicles(total_vehicles) {}
+
+/**
+ * Returns the lines of the detailed results of a junction and its roads.
+ */
+std::string payload::format_detailed_summary(const JunctionSummary &junction, const std::vector<RoadSummary> &roads) {
+
+    char line[256];
+    snprintf(line, sizeof(line), "Junction %d: %d total vehicles and %d crashes\n",
+             junction.id, junction.total_number_vehicles, junction.total_number_crashes);
+    std::string lines = line;
+
+    for (const auto &road: roads) {
+        snprintf(line, sizeof(line), "--> Road from %d to %d: Total vehicles %d and %d maximum concurrently\n",
+                 road.source_id, road.dest_id, road.total_number_vehicles, road.peak_number_vehicles);
+        lines += line;
+    }
+
+    return lines;
+}
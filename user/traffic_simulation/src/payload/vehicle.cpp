@@ -5,32 +5,76 @@
 
 namespace payload {
 
-    Vehicle::Vehicle() = default;
-
     Vehicle::Vehicle(int id, int fuel, int max_speed, int passengers, int source_id, int dest_id) :
             id(id), fuel(fuel), max_speed(max_speed), passengers(passengers), source_id(source_id), dest_id(dest_id) {
         start_time = -1;
-        speed = 0;
-        last_distance_check_secs = 0;
-        on_junction = false;
-        current_road = NULL;
-        remaining_distance = 0;
     }
 
-    Vehicle::Vehicle(int id, VehicleType type, map::RoadMapInfo &road_map_info) {
+    Vehicle::Vehicle(int id, VehicleType type, map::RoadMapInfo &road_map_info, RandomGenerator &generator) {
 
         auto attrs = vehicle_attrs[static_cast<VehicleType>(type)];
 
         this->id = id;
-        fuel = get_random_integer(road_map_info.fuel_scale_up * attrs.min_fuel,
-                                  road_map_info.fuel_scale_up * attrs.max_fuel + 1);;
+        fuel = get_random_integer(generator, road_map_info.fuel_scale_up * attrs.min_fuel,
+                                  road_map_info.fuel_scale_up * attrs.max_fuel + 1);
         max_speed = attrs.max_speed;
-        passengers = get_random_integer(1, attrs.max_passengers + 1);
+        passengers = get_random_integer(generator, 1, attrs.max_passengers + 1);
         start_time = -1;
-        speed = 0;
-        last_distance_check_secs = 0;
-        on_junction = false;
-        current_road = NULL;
-        remaining_distance = 0;
     }
-}
\ No newline at end of file
+
+    /**
+     * Append a signed integer in zigzag variable-width encoding, i.e. 7 bits per byte, so that small values
+     * of either sign take a single byte.
+     */
+    static void write_varint(int value, std::vector<char> &bytes) {
+        auto zigzag = (static_cast<unsigned int>(value) << 1) ^ static_cast<unsigned int>(value >> 31);
+        while (zigzag >= 0x80) {
+            bytes.push_back(static_cast<char>((zigzag & 0x7F) | 0x80));
+            zigzag >>= 7;
+        }
+        bytes.push_back(static_cast<char>(zigzag));
+    }
+
+    /**
+     * Read a signed integer written by `write_varint`, advancing the position.
+     */
+    static int read_varint(const char *bytes, int size, int &position) {
+        unsigned int zigzag = 0;
+        for (int shift = 0; position < size && shift < 35; shift += 7) {
+            auto byte = static_cast<unsigned char>(bytes[position++]);
+            zigzag |= static_cast<unsigned int>(byte & 0x7F) << shift;
+            if (byte < 0x80) {
+                break;
+            }
+        }
+        return static_cast<int>(zigzag >> 1) ^ -static_cast<int>(zigzag & 1);
+    }
+
+    /**
+     * Encode a batch of vehicles for the mailbox (see `mail::Type`). Each field of a vehicle is written as its
+     * difference to the same field of the previous vehicle in the batch, in variable-width encoding. Vehicles
+     * of a batch tend to have consecutive IDs and the same source junction, so most fields take one byte.
+     */
+    void encode_vehicles(const void *data, int count, std::vector<char> &bytes) {
+
+        auto vehicles = static_cast<const int *>(data);
+        bytes.reserve(bytes.size() + count * VEHICLE_NUM_INTEGERS);
+        for (int i = 0; i < count * VEHICLE_NUM_INTEGERS; i++) {
+            auto previous = i < VEHICLE_NUM_INTEGERS ? 0 : vehicles[i - VEHICLE_NUM_INTEGERS];
+            write_varint(vehicles[i] - previous, bytes);
+        }
+    }
+
+    /**
+     * Decode a batch of vehicles written by `encode_vehicles`.
+     */
+    void decode_vehicles(const char *bytes, int size, void *data, int count) {
+
+        auto vehicles = static_cast<int *>(data);
+        int position = 0;
+        for (int i = 0; i < count * VEHICLE_NUM_INTEGERS; i++) {
+            auto previous = i < VEHICLE_NUM_INTEGERS ? 0 : vehicles[i - VEHICLE_NUM_INTEGERS];
+            vehicles[i] = previous + read_varint(bytes, size, position);
+        }
+    }
+}
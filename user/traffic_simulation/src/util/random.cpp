@@ -14,4 +14,12 @@ void set_random_seed(int seed) {
  **/
 int get_random_integer(int from, int to) {
     return (rand() % (to - from)) + from;
-}
\ No newline at end of file
+}
+
+/**
+ * Generates a random integer between two values with the given generator, including the from value up to the
+ * to value minus one.
+ **/
+int get_random_integer(RandomGenerator &generator, int from, int to) {
+    return static_cast<int>(generator() % (to - from)) + from;
+}
@@ -3,44 +3,38 @@
 #include "constants/constants.h"
 #include "util/timer.h"
 
-Timer::Timer() : Timer(MIN_LENGTH_SECONDS) {}
-
-Timer::Timer(int real_seconds_to_simulation_minutes) {
-    this->simulation_minutes = 0;
-    this->start_seconds = get_current_seconds();
-    this->real_seconds_to_simulation_minutes = real_seconds_to_simulation_minutes;
-}
+Timer::Timer() : Timer(MIN_LENGTH_SECONDS, 0) {}
 
 /**
- * Returns the current Unix time in seconds.
+ * Create a timer whose simulation starts at the given time. Actors start at time 0, both in logical time and
+ * in real time, where the framework measures time from the moment actors started.
  */
-int Timer::get_current_seconds() {
-    struct timeval curr_time{};
-    gettimeofday(&curr_time, NULL);
-    return static_cast<int>(curr_time.tv_sec);
+Timer::Timer(int real_seconds_to_simulation_minutes, int start_seconds) {
+    this->simulation_minutes = 0;
+    this->start_seconds = start_seconds;
+    this->real_seconds_to_simulation_minutes = real_seconds_to_simulation_minutes;
 }
 
 // every MIN_LENGTH_SECONDS=2 is one simulated minute
 
 /**
- * Return the elapsed simulation minutes.
+ * Return the elapsed simulation minutes at the given time in seconds.
  *
- * Conversion between elapsed wall clock seconds to elapsed simulation minutes is
+ * Conversion between elapsed seconds to elapsed simulation minutes is
  * computed using real_seconds_to_simulation_minutes.
  */
-int Timer::get_simulation_minutes() const {
-    const auto current_seconds = get_current_seconds();
+int Timer::get_simulation_minutes(int current_seconds) const {
     const auto delta = current_seconds - this->start_seconds;
     return delta / this->real_seconds_to_simulation_minutes;
 }
 
 /**
- * Update the elapsed simulation minutes.
+ * Update the elapsed simulation minutes to the given time in seconds.
  * Returns true if simulation_minutes changed value.
  */
-bool Timer::update_simulation_minutes() {
+bool Timer::update_simulation_minutes(int current_seconds) {
 
-    auto t = get_simulation_minutes();
+    auto t = get_simulation_minutes(current_seconds);
     if (t == this->simulation_minutes) {
         return false;
     }
@@ -0,0 +1,60 @@
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include "payload/results.h"
+#include "payload/summary.h"
+
+/**
+ * Convert the binary results file written with BINARY_RESULTS (see `payload::ResultsHeader`) into the text
+ * format of the results file, with junctions in order of ID.
+ *
+ * Usage: convert_results <binary results file> <text results file>
+ */
+int main(int argc, char *argv[]) {
+
+    if (argc != 3) {
+        fprintf(stderr, "usage: %s <binary results file> <text results file>\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    // Read binary results file
+    std::ifstream input(argv[1], std::ios::binary);
+    if (!input) {
+        fprintf(stderr, "failed to open %s\n", argv[1]);
+        return EXIT_FAILURE;
+    }
+    std::stringstream stream;
+    stream << input.rdbuf();
+    auto bytes = stream.str();
+
+    // Read chunks of all MPI processes
+    std::vector<payload::JunctionSummary> junctions;
+    std::vector<std::vector<payload::RoadSummary>> roads;
+    long position = 0;
+    while (position < bytes.size()) {
+        if (!payload::decode_results_chunk(bytes, position, junctions, roads)) {
+            fprintf(stderr, "invalid chunk at byte %ld of %s\n", position, argv[1]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    // Write junctions in order of ID
+    std::map<int, int> order;
+    for (int i = 0; i < junctions.size(); i++) {
+        order[junctions[i].id] = i;
+    }
+
+    FILE *f = fopen(argv[2], "w");
+    if (f == nullptr) {
+        fprintf(stderr, "failed to open %s\n", argv[2]);
+        return EXIT_FAILURE;
+    }
+    for (const auto &kv: order) {
+        fputs(payload::format_detailed_summary(junctions[kv.second], roads[kv.second]).c_str(), f);
+    }
+    fclose(f);
+
+    return EXIT_SUCCESS;
+}